@@ -0,0 +1,234 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "api/api_chat_list_snapshot.h"
+
+#include "api/api_text_entities.h"
+#include "apiwrap.h"
+#include "base/unixtime.h"
+#include "data/data_peer.h"
+#include "data/data_session.h"
+#include "dialogs/dialogs_indexed_list.h"
+#include "dialogs/dialogs_main_list.h"
+#include "history/history.h"
+#include "history/history_item.h"
+#include "history/view/history_view_item_preview.h"
+#include "lang/lang_keys.h"
+#include "main/main_session.h"
+#include "storage/serialize_peer.h"
+#include "storage/storage_account.h"
+
+namespace Api {
+namespace {
+
+constexpr auto kVersion = qint32(3);
+constexpr auto kDialogsLimit = 500;
+
+template <typename Type>
+[[nodiscard]] QByteArray SerializeData(const Type &data) {
+	auto buffer = mtpBuffer();
+	data.write(buffer);
+	return QByteArray(
+		reinterpret_cast<const char*>(buffer.constData()),
+		buffer.size() * sizeof(mtpPrime));
+}
+
+template <typename Type>
+[[nodiscard]] std::optional<Type> DeserializeData(
+		const QByteArray &value) {
+	if (value.isEmpty() || (value.size() % sizeof(mtpPrime))) {
+		return std::nullopt;
+	}
+	auto result = Type();
+	auto from = reinterpret_cast<const mtpPrime*>(value.constData());
+	const auto till = from + (value.size() / sizeof(mtpPrime));
+	if (!result.read(from, till)) {
+		return std::nullopt;
+	}
+	return result;
+}
+
+[[nodiscard]] QString PreviewSender(not_null<HistoryItem*> item) {
+	if (item->isService()
+		|| item->isPost()
+		|| item->isEmpty()
+		|| item->history()->peer->isUser()) {
+		return QString();
+	} else if (const auto from = item->displayFrom()) {
+		return from->isSelf()
+			? tr::lng_from_you(tr::now)
+			: from->shortName();
+	}
+	return QString();
+}
+
+} // namespace
+
+ChatListSnapshot::ChatListSnapshot(not_null<ApiWrap*> api)
+: _session(&api->session()) {
+}
+
+void ChatListSnapshot::apply() {
+	if (_serverListReceived) {
+		return;
+	}
+	const auto serialized = _session->local().readChatListSnapshot();
+	if (serialized.isEmpty()) {
+		return;
+	}
+	QDataStream stream(serialized);
+	stream.setVersion(QDataStream::Qt_5_1);
+	auto version = qint32();
+	auto streamAppVersion = qint32();
+	auto date = qint32();
+	auto count = qint32();
+	stream >> version;
+	if (version != kVersion) {
+		return;
+	}
+	stream >> streamAppVersion >> date >> count;
+	if (stream.status() != QDataStream::Ok
+		|| count < 0
+		|| count > kDialogsLimit) {
+		return;
+	}
+	for (auto i = 0; i != count; ++i) {
+		applyEntry(stream, streamAppVersion);
+		if (stream.status() != QDataStream::Ok) {
+			break;
+		}
+	}
+	DEBUG_LOG(("Chat List Snapshot: Applied %1 chats."
+		).arg(_applied.size()));
+	_session->data().chatsListChanged(nullptr);
+	_session->data().notifyPinnedDialogsOrderUpdated();
+}
+
+void ChatListSnapshot::applyEntry(QDataStream &stream, int streamAppVersion) {
+	const auto peer = Serialize::readPeer(
+		_session,
+		streamAppVersion,
+		stream);
+	auto pinned = qint32();
+	auto date = qint32();
+	auto service = qint32();
+	auto sender = QString();
+	auto text = QString();
+	auto entities = QByteArray();
+	stream >> pinned >> date >> service >> sender >> text >> entities;
+	if (!peer || stream.status() != QDataStream::Ok) {
+		stream.setStatus(QDataStream::ReadCorruptData);
+		return;
+	}
+
+	const auto owner = &_session->data();
+	const auto history = owner->history(peer);
+	if (history->lastMessageKnown() || peer->migrateTo()) {
+		return;
+	}
+	const auto list = DeserializeData<MTPVector<MTPMessageEntity>>(
+		entities
+	).value_or(MTPVector<MTPMessageEntity>());
+	history->clearFolder();
+	history->setLocalPreview({
+		.date = date,
+		.sender = sender,
+		.text = {
+			.text = text,
+			.entities = EntitiesFromMTP(_session, list.v),
+		},
+		.service = (service != 0),
+	});
+	if (pinned) {
+		owner->setPinnedFromEntryList(history, true);
+	}
+	_applied.emplace(history);
+}
+
+void ChatListSnapshot::write() {
+	if (!_serverListReceived) {
+		return;
+	}
+	auto count = 0;
+	auto entries = QByteArray();
+	{
+		QBuffer buffer(&entries);
+		buffer.open(QIODevice::WriteOnly);
+		QDataStream stream(&buffer);
+		stream.setVersion(QDataStream::Qt_5_1);
+		for (const auto &row : *_session->data().chatsList()->indexed()) {
+			const auto history = row->history();
+			if (!history
+				|| history->peer->migrateTo()
+				|| history->isTopPromoted()
+				|| !history->chatListMessageKnown()) {
+				continue;
+			}
+			const auto item = history->chatListMessage();
+			if (!item) {
+				continue;
+			}
+			const auto preview = item->toPreview({
+				.hideSender = true,
+				.generateImages = false,
+			}).text;
+			Serialize::writePeer(stream, history->peer);
+			stream
+				<< qint32(history->isPinnedDialog(FilterId()) ? 1 : 0)
+				<< qint32(item->date())
+				<< qint32(item->isService() ? 1 : 0)
+				<< PreviewSender(item)
+				<< preview.text
+				<< SerializeData(EntitiesToMTP(
+					_session,
+					preview.entities,
+					ConvertOption::SkipLocal));
+			if (++count == kDialogsLimit) {
+				break;
+			}
+		}
+	}
+	if (!count) {
+		_session->local().writeChatListSnapshot(QByteArray());
+		return;
+	}
+
+	auto serialized = QByteArray();
+	{
+		QBuffer buffer(&serialized);
+		buffer.open(QIODevice::WriteOnly);
+		QDataStream stream(&buffer);
+		stream.setVersion(QDataStream::Qt_5_1);
+		stream
+			<< kVersion
+			<< qint32(AppVersion)
+			<< qint32(base::unixtime::now())
+			<< qint32(count);
+	}
+	serialized.append(entries);
+	_session->local().writeChatListSnapshot(serialized);
+	DEBUG_LOG(("Chat List Snapshot: Written %1 chats.").arg(count));
+}
+
+void ChatListSnapshot::listReceived() {
+	_serverListReceived = true;
+
+	// Chats that were in the snapshot, but were not sent by the server
+	// and didn't get any new messages since then, are not there anymore.
+	const auto owner = &_session->data();
+	for (const auto &history : base::take(_applied)) {
+		if (!history->localPreview()) {
+			continue;
+		}
+		history->clearLocalPreview();
+		owner->setChatPinned(history, FilterId(), false);
+		history->setChatListTimeId(0);
+		owner->removeChatListEntry(history);
+	}
+}
+
+} // namespace Api
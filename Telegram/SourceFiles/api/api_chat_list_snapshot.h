@@ -0,0 +1,48 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+#include "base/flat_set.h"
+
+class ApiWrap;
+class History;
+
+namespace Main {
+class Session;
+} // namespace Main
+
+namespace Api {
+
+// Keeps the top of the main chats list on disk, so that the list could be
+// shown right away on startup, before the server answers.
+//
+// Only the presentation is kept: peers, pinned order and a preview of the
+// top message. The preview is kept in History as row data and is never
+// registered as a message, unread state, drafts, notify settings and pts
+// always come from the server.
+class ChatListSnapshot final {
+public:
+	explicit ChatListSnapshot(not_null<ApiWrap*> api);
+
+	void apply();
+	void write();
+
+	void listReceived();
+
+private:
+	void applyEntry(QDataStream &stream, int streamAppVersion);
+
+	const not_null<Main::Session*> _session;
+
+	bool _serverListReceived = false;
+
+	base::flat_set<not_null<History*>> _applied;
+
+};
+
+} // namespace Api
@@ -10,6 +10,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "api/api_premium_option.h"
 #include "api/api_text_entities.h"
 #include "main/main_session.h"
+#include "main/main_session_bootstrap.h"
 #include "data/data_peer_values.h"
 #include "data/data_document.h"
 #include "data/data_session.h"
@@ -21,17 +22,25 @@ namespace Api {
 Premium::Premium(not_null<ApiWrap*> api)
 : _session(&api->session())
 , _api(&api->instance()) {
+	const auto refresh = [=] {
+		reload();
+		if (_session->premium()) {
+			reloadCloudSet();
+		}
+	};
+	_session->bootstrap().add({
+		.name = u"premium"_q,
+		.priority = Main::BootstrapPriority::Background,
+		.start = refresh,
+	});
 	crl::on_main(_session, [=] {
 		// You can't use _session->user() in the constructor,
 		// only queued, because it is not constructed yet.
 		Data::AmPremiumValue(
 			_session
-		) | rpl::start_with_next([=] {
-			reload();
-			if (_session->premium()) {
-				reloadCloudSet();
-			}
-		}, _session->lifetime());
+		) | rpl::skip(1) | rpl::start_with_next(
+			refresh,
+			_session->lifetime());
 	});
 }
 
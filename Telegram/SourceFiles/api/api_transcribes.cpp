@@ -13,9 +13,24 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_document.h"
 #include "data/data_session.h"
 #include "data/data_peer.h"
+#include "storage/cache/storage_cache_database.h"
 #include "apiwrap.h"
 
 namespace Api {
+namespace {
+
+void ToggleRound(not_null<HistoryItem*> item, Transcribes::Entry &entry) {
+	if (const auto media = item->media()) {
+		if (const auto document = media->document()) {
+			if (document->isVideoMessage()) {
+				entry.roundview = true;
+				document->owner().requestItemViewRefresh(item);
+			}
+		}
+	}
+}
+
+} // namespace
 
 Transcribes::Transcribes(not_null<ApiWrap*> api)
 : _session(&api->session())
@@ -58,6 +73,9 @@ void Transcribes::apply(const MTPDupdateTranscribedAudio &update) {
 	const auto text = qs(update.vtext());
 	j->second.result = text;
 	j->second.pending = update.is_pending();
+	if (!j->second.pending) {
+		cache(i->second, text);
+	}
 	if (const auto item = _session->data().message(i->second)) {
 		if (j->second.roundview) {
 			_session->data().requestItemViewRefresh(item);
@@ -70,17 +88,55 @@ void Transcribes::load(not_null<HistoryItem*> item) {
 	if (!item->isHistoryEntry() || item->isLocal()) {
 		return;
 	}
-	const auto toggleRound = [](not_null<HistoryItem*> item, Entry &entry) {
-		if (const auto media = item->media()) {
-			if (const auto document = media->document()) {
-				if (document->isVideoMessage()) {
-					entry.roundview = true;
-					document->owner().requestItemViewRefresh(item);
-				}
-			}
-		}
-	};
 	const auto id = item->fullId();
+	auto &entry = _map.emplace(id).first->second;
+	entry.shown = true;
+	entry.failed = false;
+	entry.pending = true;
+
+	const auto weak = base::make_weak(_session);
+	const auto key = Data::TranscriptionCacheKey(id);
+	_session->data().cache().get(key, [=](QByteArray &&value) {
+		crl::on_main(weak, [=, value = std::move(value)] {
+			if (value.isEmpty()) {
+				request(id);
+			} else {
+				applyCached(id, QString::fromUtf8(value));
+			}
+		});
+	});
+}
+
+void Transcribes::applyCached(FullMsgId id, QString result) {
+	const auto i = _map.find(id);
+	if (i == _map.end()) {
+		return;
+	}
+	i->second.pending = false;
+	i->second.result = std::move(result);
+	if (const auto item = _session->data().message(id)) {
+		ToggleRound(item, i->second);
+		_session->data().requestItemResize(item);
+	}
+}
+
+void Transcribes::cache(FullMsgId id, const QString &result) {
+	if (result.isEmpty()) {
+		return;
+	}
+	_session->data().cache().put(
+		Data::TranscriptionCacheKey(id),
+		Storage::Cache::Database::TaggedValue(
+			result.toUtf8(),
+			Data::kTextCacheTag));
+}
+
+void Transcribes::request(FullMsgId id) {
+	const auto item = _session->data().message(id);
+	if (!item) {
+		_map.remove(id);
+		return;
+	}
 	const auto requestId = _api.request(MTPmessages_TranscribeAudio(
 		item->history()->peer->input,
 		MTP_int(item->id)
@@ -91,8 +147,11 @@ void Transcribes::load(not_null<HistoryItem*> item) {
 		entry.pending = data.is_pending();
 		entry.result = qs(data.vtext());
 		_ids.emplace(data.vtranscription_id().v, id);
+		if (!entry.pending) {
+			cache(id, entry.result);
+		}
 		if (const auto item = _session->data().message(id)) {
-			toggleRound(item, entry);
+			ToggleRound(item, entry);
 			_session->data().requestItemResize(item);
 		}
 	}).fail([=](const MTP::Error &error) {
@@ -104,14 +163,12 @@ void Transcribes::load(not_null<HistoryItem*> item) {
 			entry.toolong = true;
 		}
 		if (const auto item = _session->data().message(id)) {
-			toggleRound(item, entry);
+			ToggleRound(item, entry);
 			_session->data().requestItemResize(item);
 		}
 	}).send();
-	auto &entry = _map.emplace(id).first->second;
+	auto &entry = _map[id];
 	entry.requestId = requestId;
-	entry.shown = true;
-	entry.failed = false;
 	entry.pending = false;
 }
 
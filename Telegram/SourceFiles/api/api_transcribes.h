@@ -38,6 +38,9 @@ public:
 
 private:
 	void load(not_null<HistoryItem*> item);
+	void request(FullMsgId id);
+	void applyCached(FullMsgId id, QString result);
+	void cache(FullMsgId id, const QString &result);
 
 	const not_null<Main::Session*> _session;
 	MTP::Sender _api;
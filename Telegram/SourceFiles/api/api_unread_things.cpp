@@ -21,9 +21,26 @@ namespace Api {
 namespace {
 
 constexpr auto kPreloadIfLess = 5;
+constexpr auto kPreloadIfLessWhenMany = 25;
 constexpr auto kFirstRequestLimit = 10;
 constexpr auto kNextRequestLimit = 100;
 
+[[nodiscard]] bool PreloadRequired(int fullCount, int loadedCount) {
+	const auto allLoaded = (fullCount >= 0) && (loadedCount >= fullCount);
+	const auto preloadIfLess = (fullCount > kNextRequestLimit)
+		? kPreloadIfLessWhenMany
+		: kPreloadIfLess;
+	return (fullCount >= 0) && !allLoaded && (loadedCount < preloadIfLess);
+}
+
+[[nodiscard]] int RequestLimit(int fullCount, int loadedCount) {
+	// With many unread things they're jumped through one by one,
+	// so there is no point in requesting a small first slice.
+	return (loadedCount > 0 || fullCount > kFirstRequestLimit)
+		? kNextRequestLimit
+		: kFirstRequestLimit;
+}
+
 } // namespace
 
 UnreadThings::UnreadThings(not_null<ApiWrap*> api) : _api(api) {
@@ -66,8 +83,7 @@ void UnreadThings::mediaAndMentionsRead(
 void UnreadThings::preloadEnoughMentions(not_null<Data::Thread*> thread) {
 	const auto fullCount = thread->unreadMentions().count();
 	const auto loadedCount = thread->unreadMentions().loadedCount();
-	const auto allLoaded = (fullCount >= 0) && (loadedCount >= fullCount);
-	if (fullCount >= 0 && loadedCount < kPreloadIfLess && !allLoaded) {
+	if (PreloadRequired(fullCount, loadedCount)) {
 		requestMentions(thread, loadedCount);
 	}
 }
@@ -75,8 +91,7 @@ void UnreadThings::preloadEnoughMentions(not_null<Data::Thread*> thread) {
 void UnreadThings::preloadEnoughReactions(not_null<Data::Thread*> thread) {
 	const auto fullCount = thread->unreadReactions().count();
 	const auto loadedCount = thread->unreadReactions().loadedCount();
-	const auto allLoaded = (fullCount >= 0) && (loadedCount >= fullCount);
-	if (fullCount >= 0 && loadedCount < kPreloadIfLess && !allLoaded) {
+	if (PreloadRequired(fullCount, loadedCount)) {
 		requestReactions(thread, loadedCount);
 	}
 }
@@ -99,7 +114,9 @@ void UnreadThings::requestMentions(
 	const auto offsetId = std::max(
 		thread->unreadMentions().maxLoaded(),
 		MsgId(1));
-	const auto limit = loaded ? kNextRequestLimit : kFirstRequestLimit;
+	const auto limit = RequestLimit(
+		thread->unreadMentions().count(),
+		loaded);
 	const auto addOffset = loaded ? -(limit + 1) : -limit;
 	const auto maxId = 0;
 	const auto minId = 0;
@@ -133,7 +150,9 @@ void UnreadThings::requestReactions(
 	const auto offsetId = loaded
 		? std::max(thread->unreadReactions().maxLoaded(), MsgId(1))
 		: MsgId(1);
-	const auto limit = loaded ? kNextRequestLimit : kFirstRequestLimit;
+	const auto limit = RequestLimit(
+		thread->unreadReactions().count(),
+		loaded);
 	const auto addOffset = loaded ? -(limit + 1) : -limit;
 	const auto maxId = 0;
 	const auto minId = 0;
@@ -31,6 +31,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "api/api_transcribes.h"
 #include "api/api_premium.h"
 #include "api/api_user_names.h"
+#include "api/api_chat_list_snapshot.h"
 #include "data/notify/data_notify_settings.h"
 #include "data/stickers/data_stickers.h"
 #include "data/data_drafts.h"
@@ -71,6 +72,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "history/history_item_components.h"
 #include "history/history_item_helpers.h"
 #include "main/main_session.h"
+#include "main/main_session_bootstrap.h"
 #include "main/main_session_settings.h"
 #include "main/main_account.h"
 #include "ui/boxes/confirm_box.h"
@@ -168,10 +170,13 @@ ApiWrap::ApiWrap(not_null<Main::Session*> session)
 , _ringtones(std::make_unique<Api::Ringtones>(this))
 , _transcribes(std::make_unique<Api::Transcribes>(this))
 , _premium(std::make_unique<Api::Premium>(this))
-, _usernames(std::make_unique<Api::Usernames>(this)) {
+, _usernames(std::make_unique<Api::Usernames>(this))
+, _chatListSnapshot(std::make_unique<Api::ChatListSnapshot>(this)) {
 	crl::on_main(session, [=] {
 		// You can't use _session->lifetime() in the constructor,
 		// only queued, because it is not constructed yet.
+		_chatListSnapshot->apply();
+
 		_session->data().chatsFilters().changed(
 		) | rpl::filter([=] {
 			return _session->data().chatsFilters().archiveNeeded();
@@ -869,6 +874,9 @@ void ApiWrap::requestMoreDialogs(Data::Folder *folder) {
 		}
 		requestMoreDialogsIfNeeded();
 		_session->data().chatsListChanged(folder);
+		if (!folder) {
+			_session->bootstrap().usable();
+		}
 	}).fail([=] {
 		dialogsLoadState(folder)->requestId = 0;
 	}).send();
@@ -982,6 +990,7 @@ void ApiWrap::dialogsLoadFinish(Data::Folder *folder) {
 		notify();
 	} else {
 		_dialogsLoadState = nullptr;
+		_chatListSnapshot->listReceived();
 		notify();
 	}
 }
@@ -3378,7 +3387,8 @@ void ApiWrap::sendVoiceMessage(
 		QByteArray result,
 		VoiceWaveform waveform,
 		int duration,
-		const SendAction &action) {
+		const SendAction &action,
+		uint64 uploadId) {
 	const auto caption = TextWithTags();
 	const auto to = fileLoadTaskOptions(action);
 	_fileLoader->addTask(std::make_unique<FileLoadTask>(
@@ -3387,7 +3397,8 @@ void ApiWrap::sendVoiceMessage(
 		duration,
 		waveform,
 		to,
-		caption));
+		caption,
+		uploadId));
 }
 
 void ApiWrap::editMedia(
@@ -4266,3 +4277,7 @@ Api::Premium &ApiWrap::premium() {
 Api::Usernames &ApiWrap::usernames() {
 	return *_usernames;
 }
+
+Api::ChatListSnapshot &ApiWrap::chatListSnapshot() {
+	return *_chatListSnapshot;
+}
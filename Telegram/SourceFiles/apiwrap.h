@@ -79,6 +79,7 @@ class Ringtones;
 class Transcribes;
 class Premium;
 class Usernames;
+class ChatListSnapshot;
 
 namespace details {
 
@@ -301,7 +302,8 @@ public:
 		QByteArray result,
 		VoiceWaveform waveform,
 		int duration,
-		const SendAction &action);
+		const SendAction &action,
+		uint64 uploadId = 0);
 	void sendFiles(
 		Ui::PreparedList &&list,
 		SendMediaType type,
@@ -381,6 +383,7 @@ public:
 	[[nodiscard]] Api::Transcribes &transcribes();
 	[[nodiscard]] Api::Premium &premium();
 	[[nodiscard]] Api::Usernames &usernames();
+	[[nodiscard]] Api::ChatListSnapshot &chatListSnapshot();
 
 	void updatePrivacyLastSeens();
 
@@ -691,6 +694,7 @@ private:
 	const std::unique_ptr<Api::Transcribes> _transcribes;
 	const std::unique_ptr<Api::Premium> _premium;
 	const std::unique_ptr<Api::Usernames> _usernames;
+	const std::unique_ptr<Api::ChatListSnapshot> _chatListSnapshot;
 
 	mtpRequestId _wallPaperRequestId = 0;
 	QString _wallPaperSlug;
@@ -15,6 +15,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_session.h"
 #include "data/data_file_origin.h"
 #include "storage/cache/storage_cache_database.h"
+#include "storage/storage_cache_stats.h"
 #include "history/view/media/history_view_media_common.h"
 #include "media/clip/media_clip_reader.h"
 #include "ui/effects/path_shift_gradient.h"
@@ -44,13 +45,18 @@ auto LottieCachedFromContent(
 		baseKey.high,
 		baseKey.low + keyShift
 	};
+	const auto stats = session->data().cacheStats();
 	const auto get = [=](FnMut<void(QByteArray &&cached)> handler) {
-		session->data().cacheBigFile().get(
-			key,
-			std::move(handler));
+		auto counted = [=, handler = std::move(handler)](
+				QByteArray &&cached) mutable {
+			stats->read(Storage::CacheStatsTag::Stickers, cached.size());
+			handler(std::move(cached));
+		};
+		session->data().cacheBigFile().get(key, std::move(counted));
 	};
 	const auto weak = base::make_weak(session);
 	const auto put = [=](QByteArray &&cached) {
+		stats->written(Storage::CacheStatsTag::Stickers, cached.size());
 		crl::on_main(weak, [=, data = std::move(cached)]() mutable {
 			weak->data().cacheBigFile().put(key, std::move(data));
 		});
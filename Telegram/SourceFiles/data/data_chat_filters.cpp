@@ -21,6 +21,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "ui/ui_utility.h"
 #include "ui/chat/more_chats_bar.h"
 #include "main/main_session.h"
+#include "main/main_session_bootstrap.h"
 #include "main/main_account.h"
 #include "main/main_app_config.h"
 #include "apiwrap.h"
@@ -324,7 +325,12 @@ ChatFilters::ChatFilters(not_null<Session*> owner)
 : _owner(owner)
 , _moreChatsTimer([=] { checkLoadMoreChatsLists(); }) {
 	_list.emplace_back();
-	crl::on_main(&owner->session(), [=] { load(); });
+	owner->session().bootstrap().add({
+		.name = u"chat_filters"_q,
+		.priority = Main::BootstrapPriority::Critical,
+		.start = [=] { load(); },
+		.finished = [=] { return changed(); },
+	});
 }
 
 ChatFilters::~ChatFilters() = default;
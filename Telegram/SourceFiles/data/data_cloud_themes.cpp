@@ -16,6 +16,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_file_origin.h"
 #include "data/data_document_media.h"
 #include "main/main_session.h"
+#include "main/main_session_bootstrap.h"
 #include "ui/boxes/confirm_box.h"
 #include "media/view/media_view_open_common.h"
 #include "lang/lang_keys.h"
@@ -24,7 +25,6 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 namespace Data {
 namespace {
 
-constexpr auto kFirstReloadTimeout = 10 * crl::time(1000);
 constexpr auto kReloadTimeout = 3600 * crl::time(1000);
 
 bool IsTestingColors/* = false*/;
@@ -134,9 +134,11 @@ CloudThemes::CloudThemes(not_null<Main::Session*> session)
 void CloudThemes::setupReload() {
 	using namespace Window::Theme;
 
-	if (needReload()) {
-		_reloadCurrentTimer.callOnce(kFirstReloadTimeout);
-	}
+	_session->bootstrap().add({
+		.name = u"cloud_theme"_q,
+		.priority = Main::BootstrapPriority::Background,
+		.start = [=] { reloadCurrent(); },
+	});
 	Background()->updates(
 	) | rpl::filter([](const BackgroundUpdate &update) {
 		return (update.type == BackgroundUpdate::Type::ApplyingTheme);
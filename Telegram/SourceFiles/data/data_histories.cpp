@@ -13,6 +13,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_folder.h"
 #include "data/data_forum.h"
 #include "data/data_forum_topic.h"
+#include "data/data_replies_list.h"
 #include "data/data_scheduled_messages.h"
 #include "base/unixtime.h"
 #include "base/random.h"
@@ -28,6 +29,12 @@ namespace Data {
 namespace {
 
 constexpr auto kReadRequestTimeout = 3 * crl::time(1000);
+constexpr auto kKeepRecentRepliesLists = 8;
+
+[[nodiscard]] bool ReceivesUpdates(not_null<History*> history) {
+	const auto channel = history->peer->asChannel();
+	return channel && channel->amIn();
+}
 
 } // namespace
 
@@ -62,12 +69,16 @@ not_null<History*> Histories::findOrCreate(PeerId peerId) {
 }
 
 void Histories::unloadAll() {
+	_recentRepliesLists.clear();
+	_repliesLists.clear();
 	for (const auto &[peerId, history] : _map) {
 		history->clear(History::ClearType::Unload);
 	}
 }
 
 void Histories::clearAll() {
+	_recentRepliesLists.clear();
+	_repliesLists.clear();
 	_map.clear();
 }
 
@@ -600,6 +611,45 @@ bool Histories::postponeEntryRequest(const State &state) const {
 	});
 }
 
+std::shared_ptr<RepliesList> Histories::repliesList(
+		not_null<History*> history,
+		MsgId rootId) {
+	const auto key = FullMsgId(history->peer->id, rootId);
+	const auto i = _repliesLists.find(key);
+	auto result = (i != end(_repliesLists))
+		? i->second.lock()
+		: nullptr;
+	if (result) {
+		_recentRepliesLists.erase(
+			ranges::remove(_recentRepliesLists, result),
+			end(_recentRepliesLists));
+
+		// We could've missed new comments while nobody was watching.
+		result->invalidateBottom();
+	} else {
+		for (auto j = begin(_repliesLists); j != end(_repliesLists);) {
+			if (j->second.expired()) {
+				j = _repliesLists.erase(j);
+			} else {
+				++j;
+			}
+		}
+		result = std::make_shared<RepliesList>(history, rootId);
+		_repliesLists[key] = result;
+	}
+
+	// Without updates edits and deletions in the loaded window are missed,
+	// so lists of groups we're not in are loaded again on each open.
+	if (!ReceivesUpdates(history)) {
+		return result;
+	}
+	_recentRepliesLists.push_back(result);
+	while (_recentRepliesLists.size() > kKeepRecentRepliesLists) {
+		_recentRepliesLists.pop_front();
+	}
+	return result;
+}
+
 void Histories::deleteMessages(
 		not_null<History*> history,
 		const QVector<MTPint> &ids,
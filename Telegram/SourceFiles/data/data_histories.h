@@ -25,6 +25,7 @@ namespace Data {
 
 class Session;
 class Folder;
+class RepliesList;
 
 class Histories final {
 public:
@@ -66,6 +67,12 @@ public:
 
 	void requestGroupAround(not_null<HistoryItem*> item);
 
+	// Comment sections are shared between viewers and kept for a while
+	// after the last one is closed, so that reopening them is instant.
+	[[nodiscard]] std::shared_ptr<RepliesList> repliesList(
+		not_null<History*> history,
+		MsgId rootId);
+
 	void deleteMessages(
 		not_null<History*> history,
 		const QVector<MTPint> &ids,
@@ -226,6 +233,9 @@ private:
 	base::flat_map<FullMsgId, MsgId> _createdTopicIds;
 	base::flat_set<mtpRequestId> _creatingTopicRequests;
 
+	base::flat_map<FullMsgId, std::weak_ptr<RepliesList>> _repliesLists;
+	std::deque<std::shared_ptr<RepliesList>> _recentRepliesLists;
+
 };
 
 } // namespace Data
@@ -10,6 +10,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "history/history.h"
 #include "history/history_item.h"
 #include "main/main_session.h"
+#include "main/main_session_bootstrap.h"
 #include "main/main_account.h"
 #include "main/main_app_config.h"
 #include "data/data_user.h"
@@ -182,7 +183,12 @@ Reactions::Reactions(not_null<Session*> owner)
 : _owner(owner)
 , _topRefreshTimer([=] { refreshTop(); })
 , _repaintTimer([=] { repaintCollected(); }) {
-	refreshDefault();
+	owner->session().bootstrap().add({
+		.name = u"reactions"_q,
+		.priority = Main::BootstrapPriority::Background,
+		.start = [=] { refreshDefault(); },
+		.finished = [=] { return defaultUpdates(); },
+	});
 
 	base::timer_each(
 		kRefreshFullListEach
@@ -156,6 +156,19 @@ void PeerClickHandler::onClick(ClickContext context) const {
 	}
 }
 
+struct PeerData::NameIndex {
+	base::flat_set<QString> words;
+	base::flat_set<QChar> firstLetters;
+};
+
+struct PeerData::Extended {
+	QString about;
+	QString themeEmoticon;
+	std::unique_ptr<Data::WallPaper> wallPaper;
+	QString requestChatTitle;
+	TimeId requestChatDate = 0;
+};
+
 PeerData::PeerData(not_null<Data::Session*> owner, PeerId id)
 : id(id)
 , _owner(owner) {
@@ -198,7 +211,10 @@ void PeerData::updateNameDelayed(
 	auto oldFirstLetters = base::flat_set<QChar>();
 	const auto nameUpdated = (_nameVersion++ > 1);
 	if (nameUpdated) {
-		oldFirstLetters = nameFirstLetters();
+		// If the index was not built, the peer was not indexed anywhere.
+		if (_nameIndex) {
+			oldFirstLetters = std::move(_nameIndex->firstLetters);
+		}
 		flags |= UpdateFlag::Name;
 	}
 	if (isUser()) {
@@ -218,7 +234,7 @@ void PeerData::updateNameDelayed(
 			flags |= UpdateFlag::Username;
 		}
 	}
-	fillNames();
+	_nameIndex = nullptr;
 	if (nameUpdated) {
 		session().changes().nameUpdated(this, std::move(oldFirstLetters));
 	}
@@ -535,10 +551,10 @@ bool PeerData::canExportChatHistory() const {
 }
 
 bool PeerData::setAbout(const QString &newAbout) {
-	if (_about == newAbout) {
+	if (about() == newAbout) {
 		return false;
 	}
-	_about = newAbout;
+	extended().about = newAbout;
 	session().changes().peerUpdated(this, UpdateFlag::About);
 	return true;
 }
@@ -582,8 +598,12 @@ void PeerData::saveTranslationDisabled(bool disabled) {
 
 void PeerData::setSettings(const MTPPeerSettings &data) {
 	data.match([&](const MTPDpeerSettings &data) {
-		_requestChatTitle = data.vrequest_chat_title().value_or_empty();
-		_requestChatDate = data.vrequest_chat_date().value_or_empty();
+		const auto title = data.vrequest_chat_title();
+		if (title || _extended) {
+			extended().requestChatTitle = title.value_or_empty();
+			extended().requestChatDate
+				= data.vrequest_chat_date().value_or_empty();
+		}
 
 		using Flag = PeerSetting;
 		setSettings((data.is_add_contact() ? Flag::AddContact : Flag())
@@ -603,9 +623,19 @@ void PeerData::setSettings(const MTPPeerSettings &data) {
 	});
 }
 
-void PeerData::fillNames() {
-	_nameWords.clear();
-	_nameFirstLetters.clear();
+const base::flat_set<QString> &PeerData::nameWords() const {
+	return nameIndex().words;
+}
+
+const base::flat_set<QChar> &PeerData::nameFirstLetters() const {
+	return nameIndex().firstLetters;
+}
+
+auto PeerData::nameIndex() const -> const NameIndex & {
+	if (_nameIndex) {
+		return *_nameIndex;
+	}
+	_nameIndex = std::make_unique<NameIndex>();
 	auto toIndexList = QStringList();
 	auto appendToIndex = [&](const QString &value) {
 		if (!value.isEmpty()) {
@@ -647,13 +677,65 @@ void PeerData::fillNames() {
 
 	const auto namesList = TextUtilities::PrepareSearchWords(toIndex);
 	for (const auto &name : namesList) {
-		_nameWords.insert(name);
-		_nameFirstLetters.insert(name[0]);
+		_nameIndex->words.insert(name);
+		_nameIndex->firstLetters.insert(name[0]);
+	}
+	return *_nameIndex;
+}
+
+auto PeerData::extended() -> Extended & {
+	if (!_extended) {
+		_extended = std::make_unique<Extended>();
 	}
+	return *_extended;
+}
+
+const QString &PeerData::about() const {
+	static const auto kEmpty = QString();
+	return _extended ? _extended->about : kEmpty;
+}
+
+QString PeerData::requestChatTitle() const {
+	return _extended ? _extended->requestChatTitle : QString();
+}
+
+TimeId PeerData::requestChatDate() const {
+	return _extended ? _extended->requestChatDate : TimeId();
 }
 
 PeerData::~PeerData() = default;
 
+PeerData::MemoryUsage PeerData::memoryUsage() const {
+	const auto string = [](const QString &value) {
+		return int64(value.capacity()) * sizeof(QChar);
+	};
+	auto result = MemoryUsage{
+		.bytes = int64(isUser()
+			? sizeof(UserData)
+			: isChat()
+			? sizeof(ChatData)
+			: sizeof(ChannelData)) + string(_name),
+		.nameIndex = (_nameIndex != nullptr),
+		.extended = (_extended != nullptr),
+	};
+	if (_nameIndex) {
+		result.bytes += sizeof(NameIndex)
+			+ _nameIndex->words.size() * sizeof(QString)
+			+ _nameIndex->firstLetters.size() * sizeof(QChar);
+		for (const auto &word : _nameIndex->words) {
+			result.bytes += string(word);
+		}
+	}
+	if (_extended) {
+		result.bytes += sizeof(Extended)
+			+ string(_extended->about)
+			+ string(_extended->themeEmoticon)
+			+ string(_extended->requestChatTitle)
+			+ (_extended->wallPaper ? sizeof(Data::WallPaper) : 0);
+	}
+	return result;
+}
+
 void PeerData::updateFull() {
 	if (!_lastFullUpdate
 		|| crl::now() > _lastFullUpdate + kUpdateFullPeerTimeout) {
@@ -1074,14 +1156,15 @@ PeerId PeerData::groupCallDefaultJoinAs() const {
 }
 
 void PeerData::setThemeEmoji(const QString &emoticon) {
-	if (_themeEmoticon == emoticon) {
+	const auto &was = themeEmoji();
+	if (was == emoticon) {
 		return;
 	}
-	if (Ui::Emoji::Find(_themeEmoticon) == Ui::Emoji::Find(emoticon)) {
-		_themeEmoticon = emoticon;
+	if (Ui::Emoji::Find(was) == Ui::Emoji::Find(emoticon)) {
+		extended().themeEmoticon = emoticon;
 		return;
 	}
-	_themeEmoticon = emoticon;
+	extended().themeEmoticon = emoticon;
 	if (!emoticon.isEmpty()
 		&& !owner().cloudThemes().themeForEmoji(emoticon)) {
 		owner().cloudThemes().refreshChatThemes();
@@ -1090,23 +1173,25 @@ void PeerData::setThemeEmoji(const QString &emoticon) {
 }
 
 const QString &PeerData::themeEmoji() const {
-	return _themeEmoticon;
+	static const auto kEmpty = QString();
+	return _extended ? _extended->themeEmoticon : kEmpty;
 }
 
 void PeerData::setWallPaper(std::optional<Data::WallPaper> paper) {
-	if (!paper && !_wallPaper) {
+	const auto was = wallPaper();
+	if (!paper && !was) {
 		return;
-	} else if (paper && _wallPaper && _wallPaper->equals(*paper)) {
+	} else if (paper && was && was->equals(*paper)) {
 		return;
 	}
-	_wallPaper = paper
+	extended().wallPaper = paper
 		? std::make_unique<Data::WallPaper>(std::move(*paper))
 		: nullptr;
 	session().changes().peerUpdated(this, UpdateFlag::ChatWallPaper);
 }
 
 const Data::WallPaper *PeerData::wallPaper() const {
-	return _wallPaper.get();
+	return _extended ? _extended->wallPaper.get() : nullptr;
 }
 
 void PeerData::setIsBlocked(bool is) {
@@ -248,12 +248,16 @@ public:
 	[[nodiscard]] const QString &topBarNameText() const;
 	[[nodiscard]] QString userName() const;
 
-	[[nodiscard]] const base::flat_set<QString> &nameWords() const {
-		return _nameWords;
-	}
-	[[nodiscard]] const base::flat_set<QChar> &nameFirstLetters() const {
-		return _nameFirstLetters;
-	}
+	[[nodiscard]] const base::flat_set<QString> &nameWords() const;
+	[[nodiscard]] const base::flat_set<QChar> &nameFirstLetters() const;
+
+	struct MemoryUsage {
+		int64 bytes = 0;
+		bool nameIndex = false;
+		bool extended = false;
+	};
+	// Approximate, for statistics in the debug log.
+	[[nodiscard]] MemoryUsage memoryUsage() const;
 
 	void setUserpic(
 		PhotoId photoId,
@@ -325,9 +329,7 @@ public:
 
 	// Returns true if about text was changed.
 	bool setAbout(const QString &newAbout);
-	[[nodiscard]] const QString &about() const {
-		return _about;
-	}
+	[[nodiscard]] const QString &about() const;
 
 	void checkFolder(FolderId folderId);
 
@@ -344,12 +346,8 @@ public:
 			? _settings.changes()
 			: (_settings.value() | rpl::type_erased());
 	}
-	[[nodiscard]] QString requestChatTitle() const {
-		return _requestChatTitle;
-	}
-	[[nodiscard]] TimeId requestChatDate() const {
-		return _requestChatDate;
-	}
+	[[nodiscard]] QString requestChatTitle() const;
+	[[nodiscard]] TimeId requestChatDate() const;
 
 	enum class TranslationFlag : uchar {
 		Unknown,
@@ -420,7 +418,11 @@ protected:
 	void invalidateEmptyUserpic();
 
 private:
-	void fillNames();
+	struct NameIndex;
+	struct Extended;
+
+	[[nodiscard]] const NameIndex &nameIndex() const;
+	[[nodiscard]] Extended &extended();
 	[[nodiscard]] not_null<Ui::EmptyUserpic*> ensureEmptyUserpic() const;
 	[[nodiscard]] virtual auto unavailableReasons() const
 		-> const std::vector<Data::UnavailableReason> &;
@@ -440,8 +442,9 @@ private:
 	Data::PeerNotifySettings _notify;
 
 	ClickHandlerPtr _openLink;
-	base::flat_set<QString> _nameWords; // for filtering
-	base::flat_set<QChar> _nameFirstLetters;
+
+	// Words for filtering, built only when the peer is searched for.
+	mutable std::unique_ptr<NameIndex> _nameIndex;
 
 	crl::time _lastFullUpdate = 0;
 
@@ -456,12 +459,9 @@ private:
 	TranslationFlag _translationFlag = TranslationFlag::Unknown;
 	bool _userpicHasVideo = false;
 
-	QString _requestChatTitle;
-	TimeId _requestChatDate = 0;
-
-	QString _about;
-	QString _themeEmoticon;
-	std::unique_ptr<Data::WallPaper> _wallPaper;
+	// Most of the peers are only seen as message authors, so the data
+	// that is known only after a full peer request is allocated lazily.
+	std::unique_ptr<Extended> _extended;
 
 };
 
@@ -488,6 +488,10 @@ bool RepliesList::applyUpdate(const MessageUpdate &update) {
 }
 
 void RepliesList::applyDifferenceTooLong() {
+	invalidateBottom();
+}
+
+void RepliesList::invalidateBottom() {
 	if (!_creating && _skippedAfter.has_value()) {
 		_skippedAfter = std::nullopt;
 		_listChanges.fire({});
@@ -33,6 +33,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "history/view/history_view_element.h"
 #include "inline_bots/inline_bot_layout_item.h"
 #include "storage/storage_account.h"
+#include "storage/storage_cache_stats.h"
 #include "storage/storage_encrypted_file.h"
 #include "media/player/media_player_instance.h" // instance()->play()
 #include "media/audio/media_audio.h"
@@ -242,6 +243,7 @@ Session::Session(not_null<Main::Session*> session)
 , _bigFileCache(Core::App().databases().get(
 	_session->local().cacheBigFilePath(),
 	_session->local().cacheBigFileSettings()))
+, _cacheStats(std::make_shared<Storage::CacheStats>())
 , _chatsList(
 	session,
 	FilterId(),
@@ -343,6 +345,10 @@ void Session::subscribeForTopicRepliesLists() {
 
 	channelDifferenceTooLong(
 	) | rpl::start_with_next([=](not_null<ChannelData*> channel) {
+		if (const auto history = historyLoaded(channel)) {
+			// Some of the unloaded messages could've been changed.
+			history->forgetLoadedWindows();
+		}
 		if (const auto forum = channel->forum()) {
 			forum->enumerateTopics([](not_null<ForumTopic*> topic) {
 				topic->replies()->applyDifferenceTooLong();
@@ -351,10 +357,36 @@ void Session::subscribeForTopicRepliesLists() {
 	}, _lifetime);
 }
 
+void Session::logMemoryUsage() const {
+	auto usage = PeerData::MemoryUsage();
+	auto nameIndices = 0;
+	auto extended = 0;
+	for (const auto &[peerId, peer] : _peers) {
+		const auto add = peer->memoryUsage();
+		usage.bytes += add.bytes;
+		nameIndices += add.nameIndex ? 1 : 0;
+		extended += add.extended ? 1 : 0;
+	}
+	DEBUG_LOG(("Peers: %1 in %2 KB (%3 per MB), "
+		"%4 with name index, %5 with extended info."
+		).arg(_peers.size()
+		).arg(usage.bytes / 1024
+		).arg(usage.bytes
+			? int64(_peers.size()) * 1024 * 1024 / usage.bytes
+			: 0
+		).arg(nameIndices
+		).arg(extended));
+	_cacheStats->log();
+}
+
 void Session::clear() {
 	// Optimization: clear notifications before destroying items.
 	Core::App().notifications().clearFromSession(_session);
 
+	if (Logs::DebugEnabled()) {
+		logMemoryUsage();
+	}
+
 	// We must clear all forums before clearing customEmojiManager.
 	// Because in Data::ForumTopic an Ui::Text::CustomEmoji is cached.
 	auto forums = base::flat_set<not_null<ChannelData*>>();
@@ -1195,6 +1227,7 @@ void Session::deleteConversationLocally(not_null<PeerData*> peer) {
 		}
 		removeChatListEntry(history);
 		history->clearFolder();
+		history->forgetLoadedWindows();
 		history->clear(peer->isChannel()
 			? History::ClearType::Unload
 			: History::ClearType::DeleteChat);
@@ -1257,6 +1290,10 @@ Storage::Cache::Database &Session::cacheBigFile() {
 	return *_bigFileCache;
 }
 
+const std::shared_ptr<Storage::CacheStats> &Session::cacheStats() {
+	return _cacheStats;
+}
+
 void Session::suggestStartExport(TimeId availableAt) {
 	_exportAvailableAt = availableAt;
 	suggestStartExport();
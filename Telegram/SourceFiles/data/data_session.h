@@ -33,6 +33,10 @@ namespace Main {
 class Session;
 } // namespace Main
 
+namespace Storage {
+class CacheStats;
+} // namespace Storage
+
 namespace Ui {
 class BoxContent;
 } // namespace Ui
@@ -159,6 +163,7 @@ public:
 
 	[[nodiscard]] Storage::Cache::Database &cache();
 	[[nodiscard]] Storage::Cache::Database &cacheBigFile();
+	[[nodiscard]] const std::shared_ptr<Storage::CacheStats> &cacheStats();
 
 	[[nodiscard]] not_null<PeerData*> peer(PeerId id);
 	[[nodiscard]] not_null<PeerData*> peer(UserId id) = delete;
@@ -720,6 +725,7 @@ private:
 	using Messages = std::unordered_map<MsgId, not_null<HistoryItem*>>;
 
 	void suggestStartExport();
+	void logMemoryUsage() const;
 
 	void setupMigrationViewer();
 	void setupChannelLeavingViewer();
@@ -844,6 +850,7 @@ private:
 
 	Storage::DatabasePointer _cache;
 	Storage::DatabasePointer _bigFileCache;
+	const std::shared_ptr<Storage::CacheStats> _cacheStats;
 
 	TimeId _exportAvailableAt = 0;
 	QPointer<Ui::BoxContent> _exportSuggestion;
@@ -22,6 +22,20 @@ constexpr auto kAudioAlbumThumbCacheTag = 0x0000000000000300ULL;
 constexpr auto kWebDocumentCacheTag = 0x0000020000000000ULL;
 constexpr auto kUrlCacheTag = 0x0000030000000000ULL;
 constexpr auto kGeoPointCacheTag = 0x0000040000000000ULL;
+constexpr auto kTranslationCacheTag = 0x0000050000000000ULL;
+constexpr auto kTranscriptionCacheTag = 0x0000060000000000ULL;
+
+[[nodiscard]] Storage::Cache::Key HashedCacheKey(
+		uint64 tag,
+		const QByteArray &data) {
+	const auto hash = openssl::Sha256(bytes::make_span(data));
+	const auto bytes = bytes::make_span(hash);
+	const auto bytes1 = bytes.subspan(0, sizeof(uint32));
+	const auto bytes2 = bytes.subspan(sizeof(uint32), sizeof(uint64));
+	const auto part1 = *reinterpret_cast<const uint32*>(bytes1.data());
+	const auto part2 = *reinterpret_cast<const uint64*>(bytes2.data());
+	return Storage::Cache::Key{ tag | part1, part2 };
+}
 
 } // namespace
 
@@ -95,6 +109,29 @@ Storage::Cache::Key AudioAlbumThumbCacheKey(
 	};
 }
 
+Storage::Cache::Key TranslationCacheKey(
+		FullMsgId itemId,
+		TimeId edited,
+		const QString &to) {
+	// Edit date is a part of the key, so edited messages are translated
+	// again, while the outdated entries just expire from the cache.
+	return HashedCacheKey(
+		kTranslationCacheTag,
+		u"%1:%2:%3:%4"_q.arg(
+			QString::number(itemId.peer.value),
+			QString::number(itemId.msg.bare),
+			QString::number(edited),
+			to).toUtf8());
+}
+
+Storage::Cache::Key TranscriptionCacheKey(FullMsgId itemId) {
+	return HashedCacheKey(
+		kTranscriptionCacheTag,
+		u"%1:%2"_q.arg(
+			QString::number(itemId.peer.value),
+			QString::number(itemId.msg.bare)).toUtf8());
+}
+
 } // namespace Data
 
 void MessageCursor::fillFrom(not_null<const Ui::InputField*> field) {
@@ -18,6 +18,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_peer.h"
 #include "data/data_message_reactions.h"
 #include "data/stickers/data_stickers.h"
+#include "storage/storage_cache_stats.h"
 #include "lottie/lottie_common.h"
 #include "lottie/lottie_frame_generator.h"
 #include "ffmpeg/ffmpeg_frame_generator.h"
@@ -279,7 +280,9 @@ void CustomEmojiLoader::startCacheLookup(
 	});
 	const auto size = FrameSizeFromTag(_tag, _sizeOverride);
 	const auto weak = base::make_weak(&lookup->process->guard);
+	const auto stats = document->owner().cacheStats();
 	document->owner().cacheBigFile().get(key, [=](QByteArray value) {
+		stats->read(Storage::CacheStatsTag::Emoji, value.size());
 		auto cache = Ui::CustomEmoji::Cache::FromSerialized(value, size);
 		crl::on_main(weak, [=, result = std::move(cache)]() mutable {
 			lookupDone(lookup, std::move(result));
@@ -344,6 +347,9 @@ void CustomEmojiLoader::check() {
 			sizeOverride);
 	};
 	auto put = [=, key = cacheKey(document)](QByteArray value) {
+		document->owner().cacheStats()->written(
+			Storage::CacheStatsTag::Emoji,
+			value.size());
 		document->owner().cacheBigFile().put(key, std::move(value));
 	};
 	const auto type = document->sticker()->type;
@@ -11,6 +11,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_forum_topic.h"
 #include "data/data_session.h"
 #include "dialogs/dialogs_list.h"
+#include "dialogs/ui/dialogs_message_view.h"
 #include "dialogs/ui/dialogs_video_userpic.h"
 #include "styles/style_dialogs.h"
 #include "styles/style_window.h"
@@ -277,6 +278,57 @@ enum class Flag {
 };
 inline constexpr bool is_flag_type(Flag) { return true; }
 
+void PaintLocalPreview(
+		Painter &p,
+		not_null<History*> history,
+		not_null<HistoryLocalPreview*> preview,
+		int left,
+		int top,
+		int availableWidth,
+		Fn<void()> customEmojiRepaint,
+		const PaintContext &context) {
+	auto &cache = preview->cache;
+	if (cache.isEmpty()) {
+		auto text = preview->service
+			? Text::Wrapped(preview->text, EntityType::PlainLink)
+			: preview->text;
+		if (!preview->sender.isEmpty()) {
+			text = PreviewWithSender(
+				{ .text = std::move(text) },
+				preview->sender,
+				{}).text;
+		}
+		const auto markedContext = Core::MarkedTextContext{
+			.session = &history->session(),
+			.customEmojiRepaint = customEmojiRepaint,
+		};
+		cache.setMarkedText(
+			st::dialogsTextStyle,
+			DialogsPreviewText(std::move(text)),
+			DialogTextOptions(),
+			markedContext);
+	}
+	p.setPen(context.active
+		? st::dialogsTextFgActive
+		: context.selected
+		? st::dialogsTextFgOver
+		: st::dialogsTextFg);
+	cache.draw(p, {
+		.position = { left, top },
+		.availableWidth = availableWidth,
+		.palette = &(context.active
+			? st::dialogsTextPaletteActive
+			: context.selected
+			? st::dialogsTextPaletteOver
+			: st::dialogsTextPalette),
+		.spoiler = Text::DefaultSpoilerCache(),
+		.now = context.now,
+		.pausedEmoji = context.paused || On(PowerSaving::kEmojiChat),
+		.pausedSpoiler = context.paused || On(PowerSaving::kChatSpoiler),
+		.elisionLines = 1,
+	});
+}
+
 template <typename PaintItemCallback>
 void PaintRow(
 		Painter &p,
@@ -523,6 +575,14 @@ void PaintRow(
 			});
 		}
 	} else if (!item) {
+		const auto local = history ? history->localPreview() : nullptr;
+		if (local && !promoted) {
+			PaintRowDate(
+				p,
+				base::unixtime::parse(local->date),
+				rectForName,
+				context);
+		}
 		auto availableWidth = namewidth;
 		if (entry->isPinnedDialog(context.filter)
 			&& (context.filter || !entry->fixedOnTopIndex())) {
@@ -550,7 +610,19 @@ void PaintRow(
 				context.width,
 				color,
 				context.now)) {
-			// Empty history
+			if (local) {
+				PaintLocalPreview(
+					p,
+					history,
+					local,
+					nameleft,
+					texttop,
+					availableWidth,
+					customEmojiRepaint,
+					context);
+			} else {
+				// Empty history
+			}
 		}
 	} else if (!item->isEmpty()) {
 		if (thread && !promoted) {
@@ -708,6 +708,9 @@ struct DialogInfo {
 	bool isLeftChannel = false;
 	QString relativePath;
 
+	// Messages up to this id were exported to the same folder last time.
+	int32 exportedTillMessageId = 0;
+
 	// Filled when requesting dialog messages.
 	std::vector<int> messagesCountPerSplit;
 };
@@ -569,6 +569,7 @@ void ApiWrap::finishStartProcess() {
 	Expects(_startProcess != nullptr);
 
 	const auto process = base::take(_startProcess);
+	process->info.selfId = *_selfId;
 	process->done(process->info);
 }
 
@@ -949,6 +950,7 @@ void ApiWrap::requestMessages(
 	_chatProcess->fileProgress = std::move(progress);
 	_chatProcess->handleSlice = std::move(slice);
 	_chatProcess->done = std::move(done);
+	_chatProcess->largestIdPlusOne = info.exportedTillMessageId + 1;
 
 	requestMessagesCount(0);
 }
@@ -957,8 +959,14 @@ void ApiWrap::requestMessagesCount(int localSplitIndex) {
 	Expects(_chatProcess != nullptr);
 	Expects(localSplitIndex < _chatProcess->info.splits.size());
 
+	const auto splitIndex = _chatProcess->info.splits[localSplitIndex];
+	if (splitIndex < 0 && _chatProcess->info.exportedTillMessageId) {
+		// Messages of the migrated group were all exported last time.
+		messagesCountLoaded(localSplitIndex, 0);
+		return;
+	}
 	requestChatMessages(
-		_chatProcess->info.splits[localSplitIndex],
+		splitIndex,
 		0, // offset_id
 		0, // add_offset
 		1, // limit
@@ -987,7 +995,39 @@ void ApiWrap::requestMessagesCount(int localSplitIndex) {
 			messagesCountLoaded(localSplitIndex, 0);
 			return;
 		}
-		checkFirstMessageDate(localSplitIndex, count);
+		if (_chatProcess->info.exportedTillMessageId > 0) {
+			requestNewMessagesCount(localSplitIndex, count);
+		} else {
+			checkFirstMessageDate(localSplitIndex, count);
+		}
+	});
+}
+
+void ApiWrap::requestNewMessagesCount(int localSplitIndex, int count) {
+	Expects(_chatProcess != nullptr);
+	Expects(localSplitIndex < _chatProcess->info.splits.size());
+
+	// Request the last exported message, its position from the end
+	// is the count of messages that will be exported this time.
+	requestChatMessages(
+		_chatProcess->info.splits[localSplitIndex],
+		_chatProcess->info.exportedTillMessageId + 1, // offset_id
+		0, // add_offset
+		1, // limit
+		[=](const MTPmessages_Messages &result) {
+		Expects(_chatProcess != nullptr);
+
+		const auto newCount = result.match(
+			[&](const MTPDmessages_messages &data) {
+			return data.vmessages().v.isEmpty() ? count : 0;
+		}, [&](const auto &data) {
+			return data.vmessages().v.isEmpty()
+				? count
+				: data.voffset_id_offset().value_or(count);
+		}, [](const MTPDmessages_messagesNotModified &data) {
+			return 0;
+		});
+		checkFirstMessageDate(localSplitIndex, std::min(newCount, count));
 	});
 }
 
@@ -1667,7 +1707,8 @@ void ApiWrap::finishMessagesSlice() {
 		&& (++_chatProcess->localSplitIndex
 			< _chatProcess->info.splits.size())) {
 		_chatProcess->lastSlice = false;
-		_chatProcess->largestIdPlusOne = 1;
+		_chatProcess->largestIdPlusOne
+			= _chatProcess->info.exportedTillMessageId + 1;
 	}
 	if (!_chatProcess->lastSlice) {
 		requestMessagesSlice();
@@ -45,6 +45,7 @@ public:
 	struct StartInfo {
 		int userpicsCount = 0;
 		int dialogsCount = 0;
+		UserId selfId = 0;
 	};
 	void startExport(
 		const Settings &settings,
@@ -148,6 +149,7 @@ private:
 		int splitIndex);
 
 	void requestMessagesCount(int localSplitIndex);
+	void requestNewMessagesCount(int localSplitIndex, int count);
 	void checkFirstMessageDate(int localSplitIndex, int count);
 	void messagesCountLoaded(int localSplitIndex, int count);
 	void requestMessagesSlice();
@@ -13,13 +13,80 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "export/output/export_output_abstract.h"
 #include "export/output/export_output_result.h"
 #include "export/output/export_output_stats.h"
+#include "export/output/export_output_zip.h"
 #include "mtproto/mtp_instance.h"
 
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QJsonArray>
+
 namespace Export {
 namespace {
 
 const auto kNullStateCallback = [](ProcessingState&) {};
 
+struct ExportedState {
+	UserId selfId = 0;
+	base::flat_map<PeerId, int32> exportedTill;
+};
+
+[[nodiscard]] QString ExportedStatePath(const QString &folder) {
+	return QDir(folder).absoluteFilePath(u"export_state.json"_q);
+}
+
+[[nodiscard]] ExportedState ReadExportedState(const QString &folder) {
+	QFile file(ExportedStatePath(folder));
+	if (!file.open(QIODevice::ReadOnly)) {
+		return {};
+	}
+	auto error = QJsonParseError{ 0, QJsonParseError::NoError };
+	const auto document = QJsonDocument::fromJson(file.readAll(), &error);
+	if (error.error != QJsonParseError::NoError || !document.isObject()) {
+		LOG(("Export Error: Could not parse '%1'.").arg(file.fileName()));
+		return {};
+	}
+	const auto object = document.object();
+	auto result = ExportedState{
+		.selfId = UserId(
+			object.value("self_id").toString().toULongLong()),
+	};
+	for (const auto &value : object.value("chats").toArray()) {
+		const auto chat = value.toObject();
+		const auto peerId = PeerId(
+			chat.value("peer_id").toString().toULongLong());
+		const auto till = chat.value("last_message_id").toInt();
+		if (peerId && till > 0) {
+			result.exportedTill.emplace(peerId, till);
+		}
+	}
+	return result;
+}
+
+[[nodiscard]] Output::Result WriteExportedState(
+		const QString &folder,
+		const ExportedState &state) {
+	auto chats = QJsonArray();
+	for (const auto &[peerId, till] : state.exportedTill) {
+		auto chat = QJsonObject();
+		chat.insert("peer_id", QString::number(peerId.value));
+		chat.insert("last_message_id", till);
+		chats.push_back(chat);
+	}
+	auto object = QJsonObject();
+	object.insert("self_id", QString::number(state.selfId.bare));
+	object.insert("chats", chats);
+
+	QFile file(ExportedStatePath(folder));
+	if (!file.open(QIODevice::WriteOnly)) {
+		return Output::Result(Output::Result::Type::Error, file.fileName());
+	}
+	const auto content = QJsonDocument(object).toJson();
+	if (file.write(content) != content.size()) {
+		return Output::Result(Output::Result::Type::Error, file.fileName());
+	}
+	return Output::Result::Success();
+}
+
 Settings NormalizeSettings(const Settings &settings) {
 	if (!settings.onlySinglePeer()) {
 		return base::duplicate(settings);
@@ -37,6 +104,7 @@ public:
 		crl::weak_on_queue<ControllerObject> weak,
 		QPointer<MTP::Instance> mtproto,
 		const MTPInputPeer &peer);
+	~ControllerObject();
 
 	rpl::producer<State> state() const;
 
@@ -80,6 +148,11 @@ private:
 	void exportOtherData();
 	void exportDialogs();
 	void exportNextDialog();
+	void skipExportedDialogs();
+	bool writeExportedState();
+	void packToArchive();
+	void archivePacked(Output::Result result);
+	void finishExport();
 
 	template <typename Callback = const decltype(kNullStateCallback) &>
 	ProcessingState prepareState(
@@ -101,6 +174,7 @@ private:
 
 	int substepsInStep(Step step) const;
 
+	crl::weak_on_queue<ControllerObject> _weak;
 	ApiWrap _api;
 	Settings _settings;
 	Environment _environment;
@@ -108,6 +182,12 @@ private:
 	Data::DialogsInfo _dialogsInfo;
 	int _dialogIndex = -1;
 
+	QString _stateFolder;
+	ExportedState _exported;
+	QString _archivePath;
+	QString _localFolder;
+	std::shared_ptr<std::atomic<bool>> _packingStopped;
+
 	int _messagesWritten = 0;
 	int _messagesCount = 0;
 
@@ -137,7 +217,8 @@ ControllerObject::ControllerObject(
 	crl::weak_on_queue<ControllerObject> weak,
 	QPointer<MTP::Instance> mtproto,
 	const MTPInputPeer &peer)
-: _api(mtproto, weak.runner())
+: _weak(weak)
+, _api(mtproto, weak.runner())
 , _state(PasswordCheckState{}) {
 	_api.errors(
 	) | rpl::start_with_next([=](const MTP::Error &error) {
@@ -157,6 +238,16 @@ ControllerObject::ControllerObject(
 	setState(std::move(state));
 }
 
+ControllerObject::~ControllerObject() {
+	_writer = nullptr;
+	if (_packingStopped) {
+		// The packing thread removes the local folder itself.
+		*_packingStopped = true;
+	} else if (!_localFolder.isEmpty()) {
+		QDir(_localFolder).removeRecursively();
+	}
+}
+
 rpl::producer<State> ControllerObject::state() const {
 	return rpl::single(
 		_state
@@ -248,7 +339,27 @@ void ControllerObject::startExport(
 	_settings = NormalizeSettings(settings);
 	_environment = environment;
 
+	// Each export to a non-empty folder is put to a new subfolder,
+	// so the exported state is kept in the folder chosen by the user.
+	_stateFolder = _settings.path;
+	if (_settings.onlyNewMessages) {
+		_exported = ReadExportedState(_stateFolder);
+	}
+	if (_settings.packToArchive) {
+		_settings.forceSubPath = true;
+	}
 	_settings.path = Output::NormalizePath(_settings);
+	if (_settings.packToArchive) {
+		// The files are written to a local folder and only the archive
+		// is put to the chosen folder, that may be on a slow drive.
+		_archivePath = Output::ArchivePath(_settings.path);
+		_localFolder = _environment.temporaryPath
+			+ u"export/"_q
+			+ QDir(_settings.path).dirName()
+			+ '/';
+		QDir(_localFolder).removeRecursively();
+		_settings.path = _localFolder;
+	}
 	_writer = Output::CreateWriter(_settings.format);
 	fillExportSteps();
 	exportNext();
@@ -323,6 +434,9 @@ void ControllerObject::fillSubstepsInSteps(const ApiWrap::StartInfo &info) {
 }
 
 void ControllerObject::cancelExportFast() {
+	if (_packingStopped) {
+		*_packingStopped = true;
+	}
 	_api.cancelExportFast();
 	setState(CancelledState());
 }
@@ -331,10 +445,11 @@ void ControllerObject::exportNext() {
 	if (++_stepIndex >= _steps.size()) {
 		if (ioCatchError(_writer->finish())) {
 			return;
+		} else if (_settings.packToArchive) {
+			packToArchive();
+		} else {
+			finishExport();
 		}
-		_api.finishExport([=] {
-			setFinishedState();
-		});
 		return;
 	}
 
@@ -363,6 +478,9 @@ void ControllerObject::initialized(const ApiWrap::StartInfo &info) {
 	if (ioCatchError(_writer->start(_settings, _environment, &_stats))) {
 		return;
 	}
+	if (_exported.selfId != info.selfId) {
+		_exported = ExportedState{ .selfId = info.selfId };
+	}
 	fillSubstepsInSteps(info);
 	exportNext();
 }
@@ -376,6 +494,7 @@ void ControllerObject::collectDialogsList() {
 		return true;
 	}, [=](Data::DialogsInfo &&result) {
 		_dialogsInfo = std::move(result);
+		skipExportedDialogs();
 		exportNext();
 	});
 }
@@ -476,6 +595,11 @@ void ControllerObject::exportNextDialog() {
 			if (ioCatchError(_writer->writeDialogSlice(result))) {
 				return false;
 			}
+			auto &till = _exported.exportedTill[info->peerId];
+			for (const auto &message : result.list) {
+				// Messages of migrated groups have negative ids here.
+				till = std::max(till, message.id);
+			}
 			_messagesWritten += result.list.size();
 			setState(stateDialogs(DownloadProgress()));
 			return true;
@@ -493,6 +617,74 @@ void ControllerObject::exportNextDialog() {
 	exportNext();
 }
 
+void ControllerObject::skipExportedDialogs() {
+	if (_exported.exportedTill.empty()) {
+		return;
+	}
+	const auto process = [&](std::vector<Data::DialogInfo> &list) {
+		for (auto &info : list) {
+			const auto i = _exported.exportedTill.find(info.peerId);
+			if (i != end(_exported.exportedTill)) {
+				info.exportedTillMessageId = i->second;
+			}
+		}
+		const auto nothingNew = [](const Data::DialogInfo &info) {
+			return (info.topMessageId > 0)
+				&& (info.topMessageId <= info.exportedTillMessageId);
+		};
+		list.erase(ranges::remove_if(list, nothingNew), end(list));
+	};
+	process(_dialogsInfo.chats);
+	process(_dialogsInfo.left);
+}
+
+bool ControllerObject::writeExportedState() {
+	if (!_settings.onlyNewMessages
+		|| !(_settings.types & Settings::Type::AnyChatsMask)
+		|| _settings.onlySinglePeer()) {
+		return true;
+	}
+	return !ioCatchError(WriteExportedState(_stateFolder, _exported));
+}
+
+void ControllerObject::packToArchive() {
+	const auto folder = _localFolder;
+	const auto archive = _archivePath;
+	LOG(("Export Info: Packing '%1' to '%2'.").arg(folder, archive));
+
+	// Don't block the export queue while the files are packed.
+	const auto stopped = std::make_shared<std::atomic<bool>>(false);
+	_packingStopped = stopped;
+	crl::async([=, weak = _weak] {
+		auto result = Output::PackToArchive(folder, archive, [=] {
+			return stopped->load();
+		});
+		if (!result || *stopped) {
+			QFile::remove(archive);
+		}
+		QDir(folder).removeRecursively();
+		weak.with([=](ControllerObject &that) {
+			that.archivePacked(result);
+		});
+	});
+}
+
+void ControllerObject::archivePacked(Output::Result result) {
+	if (stopped() || ioCatchError(result)) {
+		return;
+	}
+	finishExport();
+}
+
+void ControllerObject::finishExport() {
+	if (!writeExportedState()) {
+		return;
+	}
+	_api.finishExport([=] {
+		setFinishedState();
+	});
+}
+
 template <typename Callback>
 ProcessingState ControllerObject::prepareState(
 		Step step,
@@ -604,7 +796,7 @@ int ControllerObject::substepsInStep(Step step) const {
 
 void ControllerObject::setFinishedState() {
 	setState(FinishedState{
-		_writer->mainFilePath(),
+		(_archivePath.isEmpty() ? _writer->mainFilePath() : _archivePath),
 		_stats.filesCount(),
 		_stats.bytesCount() });
 }
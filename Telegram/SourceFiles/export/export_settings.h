@@ -83,6 +83,12 @@ struct Settings {
 
 	TimeId availableAt = 0;
 
+	// Skip messages exported to the same folder last time.
+	bool onlyNewMessages = false;
+
+	// Pack the exported folder to a single ZIP archive.
+	bool packToArchive = false;
+
 	bool onlySinglePeer() const {
 		return singlePeer.type() != mtpc_inputPeerEmpty;
 	}
@@ -104,6 +110,7 @@ struct Settings {
 
 struct Environment {
 	QString internalLinksDomain;
+	QString temporaryPath;
 	QByteArray aboutTelegram;
 	QByteArray aboutContacts;
 	QByteArray aboutFrequent;
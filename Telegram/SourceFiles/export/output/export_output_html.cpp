@@ -15,12 +15,17 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include <QtCore/QSize>
 #include <QtCore/QFile>
 #include <QtCore/QDateTime>
+#include <QtCore/QSemaphore>
+
+#include <thread>
 
 namespace Export {
 namespace Output {
 namespace {
 
 constexpr auto kMessagesInFile = 1000;
+constexpr auto kMaxRenderThreads = 8;
+constexpr auto kMinMessagesPerRenderJob = 25;
 constexpr auto kPersonalUserpicSize = 90;
 constexpr auto kEntryUserpicSize = 48;
 constexpr auto kServiceMessagePhotoSize = 60;
@@ -543,9 +548,14 @@ public:
 	[[nodiscard]] QString relativePath(const QString &path) const;
 	[[nodiscard]] QString relativePath(const Data::File &file) const;
 
+	// Renders to the same place without a file, for another thread.
+	[[nodiscard]] std::unique_ptr<Wrap> fork() const;
+
 	~Wrap();
 
 private:
+	Wrap(const QByteArray &base, const Context &context);
+
 	[[nodiscard]] QByteArray composeStart();
 	[[nodiscard]] QByteArray pushGenericListEntry(
 		const QString &link,
@@ -660,6 +670,17 @@ HtmlWriter::Wrap::Wrap(
 	_composedStart = composeStart();
 }
 
+HtmlWriter::Wrap::Wrap(const QByteArray &base, const Context &context)
+: _file(QString(), nullptr)
+, _closed(true)
+, _base(base)
+, _context(context) {
+}
+
+auto HtmlWriter::Wrap::fork() const -> std::unique_ptr<Wrap> {
+	return std::unique_ptr<Wrap>(new Wrap(_base, _context));
+}
+
 bool HtmlWriter::Wrap::empty() const {
 	return _file.empty();
 }
@@ -2472,19 +2493,20 @@ Result HtmlWriter::writeDialogSlice(const Data::MessagesSlice &data) {
 	Expects(_chat != nullptr);
 	Expects(!data.list.empty());
 
-	const auto messageLinkWrapper = [&](int messageId, QByteArray text) {
-		return wrapMessageLink(messageId, text);
-	};
+	auto list = std::vector<not_null<const Data::Message*>>();
+	list.reserve(data.list.size());
+	for (const auto &message : data.list) {
+		if (!Data::SkipMessageByDate(message, _settings)) {
+			list.push_back(&message);
+		}
+	}
 	auto oldIndex = (_messagesCount > 0)
 		? ((_messagesCount - 1) / kMessagesInFile)
 		: 0;
 	auto previous = _lastMessageInfo.get();
 	auto saved = std::optional<MessageInfo>();
 	auto block = QByteArray();
-	for (const auto &message : data.list) {
-		if (Data::SkipMessageByDate(message, _settings)) {
-			continue;
-		}
+	for (auto from = 0, count = int(list.size()); from != count;) {
 		const auto newIndex = (_messagesCount / kMessagesInFile);
 		if (oldIndex != newIndex) {
 			if (const auto result = _chat->writeBlock(block); !result) {
@@ -2509,32 +2531,112 @@ Result HtmlWriter::writeDialogSlice(const Data::MessagesSlice &data) {
 			}
 			_chatFileEmpty = false;
 		}
-		const auto date = message.date;
-		if (DisplayDate(date, previous ? previous->date : 0)) {
-			block.append(_chat->pushServiceMessage(
-				--_dateMessageId,
+
+		// Links to other messages depend on the file they're in, so all
+		// messages of one file are rendered before switching to the next.
+		const auto left = kMessagesInFile - (_messagesCount % kMessagesInFile);
+		const auto till = from + std::min(count - from, left);
+		auto rendered = renderMessages(
+			list,
+			from,
+			till,
+			previous,
+			data.peers);
+		for (auto i = from; i != till; ++i) {
+			const auto date = list[i]->date;
+			if (DisplayDate(date, previous ? previous->date : 0)) {
+				block.append(_chat->pushServiceMessage(
+					--_dateMessageId,
+					_dialog,
+					_settings.path,
+					FormatDateText(date)));
+			}
+			auto &[info, content] = rendered[i - from];
+			block.append(content);
+
+			++_messagesCount;
+			saved = std::move(info);
+			previous = &*saved;
+		}
+		from = till;
+	}
+	if (saved) {
+		_lastMessageInfo = std::make_unique<MessageInfo>(*saved);
+	}
+	return block.isEmpty() ? Result::Success() : _chat->writeBlock(block);
+}
+
+auto HtmlWriter::renderMessages(
+	const std::vector<not_null<const Data::Message*>> &list,
+	int from,
+	int till,
+	const MessageInfo *previous,
+	const PeersMap &peers)
+-> std::vector<std::pair<MessageInfo, QByteArray>> {
+	Expects(_chat != nullptr);
+	Expects(from >= 0 && from < till && till <= list.size());
+
+	const auto started = crl::now();
+	const auto count = till - from;
+	const auto threads = std::clamp(
+		int(std::thread::hardware_concurrency()),
+		1,
+		kMaxRenderThreads);
+	const auto jobs = std::clamp(count / kMinMessagesPerRenderJob, 1, threads);
+	const auto perJob = (count + jobs - 1) / jobs;
+	const auto messageLinkWrapper = [=](int messageId, QByteArray text) {
+		return wrapMessageLink(messageId, text);
+	};
+	auto result = std::vector<std::pair<MessageInfo, QByteArray>>(count);
+	const auto render = [&](not_null<Wrap*> wrap, int first, int last) {
+		auto info = (first > 0) ? nullptr : previous;
+		for (auto i = first; i != last; ++i) {
+			result[i] = wrap->pushMessage(
+				*list[from + i],
+				info,
 				_dialog,
 				_settings.path,
-				FormatDateText(date)));
+				peers,
+				_environment.internalLinksDomain,
+				messageLinkWrapper);
+			info = &result[i].first;
 		}
-		const auto [info, content] = _chat->pushMessage(
-			message,
-			previous,
+	};
+
+	// Each job renders its messages with its own copy of the current
+	// tags context, the nesting is the same between any two messages.
+	QSemaphore semaphore;
+	auto forks = std::vector<std::unique_ptr<Wrap>>();
+	forks.reserve(jobs - 1);
+	for (auto job = 1; job != jobs; ++job) {
+		const auto first = std::min(job * perJob, count);
+		const auto last = std::min(first + perJob, count);
+		const auto wrap = forks.emplace_back(_chat->fork()).get();
+		crl::async([=, &render, &semaphore] {
+			render(wrap, first, last);
+			semaphore.release();
+		});
+	}
+	render(_chat.get(), 0, std::min(perJob, count));
+	semaphore.acquire(jobs - 1);
+
+	// The first message of each job was rendered without the previous one,
+	// render it once again now that the previous message info is known,
+	// so the result is the same as if all of them were rendered in order.
+	for (auto i = perJob; i < count; i += perJob) {
+		result[i] = _chat->pushMessage(
+			*list[from + i],
+			&result[i - 1].first,
 			_dialog,
 			_settings.path,
-			data.peers,
+			peers,
 			_environment.internalLinksDomain,
 			messageLinkWrapper);
-		block.append(content);
-
-		++_messagesCount;
-		saved = info;
-		previous = &*saved;
 	}
-	if (saved) {
-		_lastMessageInfo = std::make_unique<MessageInfo>(*saved);
-	}
-	return block.isEmpty() ? Result::Success() : _chat->writeBlock(block);
+
+	_renderedCount += count;
+	_renderTime += crl::now() - started;
+	return result;
 }
 
 Result HtmlWriter::writeEmptySinglePeer() {
@@ -2786,6 +2888,11 @@ Result HtmlWriter::switchToNextChatFile(int index) {
 Result HtmlWriter::finish() {
 	Expects(_settings.onlySinglePeer() || _summary != nullptr);
 
+	if (_renderedCount > 0) {
+		DEBUG_LOG(("Export Info: Rendered %1 messages in %2 ms."
+			).arg(_renderedCount
+			).arg(_renderTime));
+	}
 	if (_settings.onlySinglePeer()) {
 		return Result::Success();
 	}
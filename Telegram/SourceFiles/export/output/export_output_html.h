@@ -81,6 +81,7 @@ private:
 	using Context = details::HtmlContext;
 	using UserpicData = details::UserpicData;
 	using MediaData = details::MediaData;
+	using PeersMap = details::PeersMap;
 	class Wrap;
 	struct MessageInfo;
 	enum class DialogsMode {
@@ -108,6 +109,13 @@ private:
 	[[nodiscard]] Result validateDialogsMode(bool isLeftChannel);
 	[[nodiscard]] Result writeDialogOpening(int index);
 	[[nodiscard]] Result switchToNextChatFile(int index);
+	[[nodiscard]] auto renderMessages(
+		const std::vector<not_null<const Data::Message*>> &list,
+		int from,
+		int till,
+		const MessageInfo *previous,
+		const PeersMap &peers)
+	-> std::vector<std::pair<MessageInfo, QByteArray>>;
 	[[nodiscard]] Result writeEmptySinglePeer();
 
 	void pushSection(
@@ -160,6 +168,8 @@ private:
 	std::unique_ptr<Wrap> _chat;
 	std::vector<int> _lastMessageIdsPerFile;
 	bool _chatFileEmpty = false;
+	int _renderedCount = 0;
+	crl::time _renderTime = 0;
 
 };
 
@@ -0,0 +1,166 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "export/output/export_output_zip.h"
+
+#include "export/output/export_output_result.h"
+#include "base/zlib_help.h"
+
+#include <QtCore/QDirIterator>
+#include <QtCore/QFileInfo>
+#include <QtCore/QDir>
+
+#include <gsl/util>
+
+namespace Export {
+namespace Output {
+namespace {
+
+constexpr auto kReadBlockSize = 1024 * 1024;
+
+// General purpose bit 11: file names are encoded in UTF-8.
+constexpr auto kUtf8NameFlag = (1 << 11);
+
+[[nodiscard]] bool AlreadyCompressed(const QString &path) {
+	static const auto extensions = base::flat_set<QString>{
+		u"jpg"_q,
+		u"jpeg"_q,
+		u"png"_q,
+		u"webp"_q,
+		u"gif"_q,
+		u"mp4"_q,
+		u"mov"_q,
+		u"webm"_q,
+		u"mp3"_q,
+		u"m4a"_q,
+		u"ogg"_q,
+		u"oga"_q,
+		u"opus"_q,
+		u"tgs"_q,
+		u"zip"_q,
+	};
+	return extensions.contains(QFileInfo(path).suffix().toLower());
+}
+
+[[nodiscard]] zip_fileinfo PrepareInfo(const QFileInfo &info) {
+	const auto modified = info.lastModified();
+	const auto date = modified.date();
+	const auto time = modified.time();
+	auto result = zip_fileinfo();
+	result.tmz_date.tm_sec = time.second();
+	result.tmz_date.tm_min = time.minute();
+	result.tmz_date.tm_hour = time.hour();
+	result.tmz_date.tm_mday = date.day();
+	result.tmz_date.tm_mon = date.month() - 1;
+	result.tmz_date.tm_year = date.year();
+	return result;
+}
+
+} // namespace
+
+QString ArchivePath(const QString &folder) {
+	auto base = QDir(folder).absolutePath();
+	while (base.endsWith('/')) {
+		base.chop(1);
+	}
+	const auto add = [&](int i) {
+		return base
+			+ (i ? " (" + QString::number(i) + ')' : QString())
+			+ u".zip"_q;
+	};
+	auto index = 0;
+	while (QFile::exists(add(index))) {
+		++index;
+	}
+	return add(index);
+}
+
+Result PackToArchive(
+		const QString &folder,
+		const QString &archive,
+		Fn<bool()> stopped) {
+	const auto error = [&](const QString &path) {
+		return Result(Result::Type::FatalError, path);
+	};
+	auto zip = zipOpen64(
+		QFile::encodeName(archive).constData(),
+		APPEND_STATUS_CREATE);
+	if (!zip) {
+		return error(archive);
+	}
+	const auto guard = gsl::finally([&] {
+		if (zip) {
+			zipClose(zip, nullptr);
+		}
+	});
+
+	const auto root = QDir(folder);
+	auto buffer = QByteArray(kReadBlockSize, Qt::Uninitialized);
+	QDirIterator i(
+		folder,
+		QDir::Files | QDir::Hidden,
+		QDirIterator::Subdirectories);
+	while (i.hasNext()) {
+		if (stopped()) {
+			return error(archive);
+		}
+		const auto path = i.next();
+		const auto name = root.relativeFilePath(path).toUtf8();
+		const auto info = PrepareInfo(i.fileInfo());
+		const auto store = AlreadyCompressed(path);
+		QFile file(path);
+		if (!file.open(QIODevice::ReadOnly)) {
+			return error(path);
+		}
+		const auto opened = zipOpenNewFileInZip4_64(
+			zip,
+			name.constData(),
+			&info,
+			nullptr,
+			0,
+			nullptr,
+			0,
+			nullptr,
+			store ? 0 : Z_DEFLATED,
+			store ? 0 : Z_DEFAULT_COMPRESSION,
+			0, // raw
+			-MAX_WBITS,
+			DEF_MEM_LEVEL,
+			Z_DEFAULT_STRATEGY,
+			nullptr, // password
+			0, // crcForCrypting
+			0, // versionMadeBy
+			kUtf8NameFlag,
+			(file.size() >= 0xFFFFFFFFLL) ? 1 : 0);
+		if (opened != ZIP_OK) {
+			return error(archive);
+		}
+		while (!file.atEnd()) {
+			if (stopped()) {
+				return error(archive);
+			}
+			const auto read = file.read(buffer.data(), buffer.size());
+			if (read < 0) {
+				return error(path);
+			} else if (zipWriteInFileInZip(
+					zip,
+					buffer.constData(),
+					unsigned(read)) != ZIP_OK) {
+				return error(archive);
+			}
+		}
+		if (zipCloseFileInZip(zip) != ZIP_OK) {
+			return error(archive);
+		}
+	}
+	return (zipClose(base::take(zip), nullptr) == ZIP_OK)
+		? Result::Success()
+		: error(archive);
+}
+
+} // namespace Output
+} // namespace Export
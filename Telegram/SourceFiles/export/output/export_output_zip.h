@@ -0,0 +1,30 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+#include <QtCore/QString>
+
+namespace Export {
+namespace Output {
+
+struct Result;
+
+// Returns "<folder>.zip", or "<folder> (n).zip" if that file exists.
+[[nodiscard]] QString ArchivePath(const QString &folder);
+
+// Packs all files of the folder to the archive, keeping relative paths.
+// Already compressed media is stored as is, text files are deflated.
+// Returns an error as soon as the stopped() callback returns true.
+// Called from a background thread.
+[[nodiscard]] Result PackToArchive(
+	const QString &folder,
+	const QString &archive,
+	Fn<bool()> stopped);
+
+} // namespace Output
+} // namespace Export
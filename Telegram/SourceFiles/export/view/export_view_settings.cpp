@@ -275,6 +275,48 @@ void SettingsWidget::setupPathAndFormat(
 	addLocationLabel(container);
 	addFormatOption(tr::lng_export_option_html(tr::now), Format::Html);
 	addFormatOption(tr::lng_export_option_json(tr::now), Format::Json);
+	addOnlyNewOption(container);
+	addArchiveOption(container);
+}
+
+void SettingsWidget::addArchiveOption(
+		not_null<Ui::VerticalLayout*> container) {
+	const auto checkbox = container->add(
+		object_ptr<Ui::Checkbox>(
+			container,
+			tr::lng_export_option_archive(tr::now),
+			readData().packToArchive,
+			st::defaultBoxCheckbox),
+		st::exportSettingPadding);
+	checkbox->checkedChanges(
+	) | rpl::start_with_next([=](bool checked) {
+		changeData([&](Settings &data) {
+			data.packToArchive = checked;
+		});
+	}, checkbox->lifetime());
+}
+
+void SettingsWidget::addOnlyNewOption(
+		not_null<Ui::VerticalLayout*> container) {
+	const auto checkbox = container->add(
+		object_ptr<Ui::Checkbox>(
+			container,
+			tr::lng_export_option_only_new(tr::now),
+			readData().onlyNewMessages,
+			st::defaultBoxCheckbox),
+		st::exportSettingPadding);
+	container->add(
+		object_ptr<Ui::FlatLabel>(
+			container,
+			tr::lng_export_option_only_new_about(tr::now),
+			st::exportAboutOptionLabel),
+		st::exportAboutOptionPadding);
+	checkbox->checkedChanges(
+	) | rpl::start_with_next([=](bool checked) {
+		changeData([&](Settings &data) {
+			data.onlyNewMessages = checked;
+		});
+	}, checkbox->lifetime());
 }
 
 void SettingsWidget::addLocationLabel(
@@ -84,6 +84,8 @@ private:
 	void addSizeSlider(not_null<Ui::VerticalLayout*> container);
 	void addLocationLabel(
 		not_null<Ui::VerticalLayout*> container);
+	void addOnlyNewOption(not_null<Ui::VerticalLayout*> container);
+	void addArchiveOption(not_null<Ui::VerticalLayout*> container);
 	void addFormatAndLocationLabel(
 		not_null<Ui::VerticalLayout*> container);
 	void addLimitsLabel(
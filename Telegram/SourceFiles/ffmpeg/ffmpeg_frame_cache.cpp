@@ -0,0 +1,178 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "ffmpeg/ffmpeg_frame_cache.h"
+
+#include "ffmpeg/ffmpeg_utility.h"
+
+#include <xxhash.h>
+
+namespace FFmpeg {
+namespace {
+
+constexpr auto kMaxLoopFrames = 600;
+constexpr auto kMaxLoopBytes = int64(8 * 1024 * 1024);
+constexpr auto kMaxCacheBytes = int64(64 * 1024 * 1024);
+
+struct Run {
+	uint16 zeros = 0;
+	uint16 literals = 0;
+};
+
+[[nodiscard]] QByteArray Pack(const QImage &image) {
+	const auto width = image.width();
+	const auto height = image.height();
+	auto result = QByteArray();
+	result.reserve(width * height * sizeof(uint32) / 2);
+	for (auto y = 0; y != height; ++y) {
+		const auto row = reinterpret_cast<const uint32*>(
+			image.constScanLine(y));
+		auto x = 0;
+		while (x != width) {
+			const auto zerosFrom = x;
+			while (x != width && !row[x]) {
+				++x;
+			}
+			const auto literalsFrom = x;
+			while (x != width && row[x]) {
+				++x;
+			}
+			const auto run = Run{
+				.zeros = uint16(literalsFrom - zerosFrom),
+				.literals = uint16(x - literalsFrom),
+			};
+			result.append(
+				reinterpret_cast<const char*>(&run),
+				sizeof(run));
+			result.append(
+				reinterpret_cast<const char*>(row + literalsFrom),
+				run.literals * sizeof(uint32));
+		}
+	}
+	result.squeeze();
+	return result;
+}
+
+void Unpack(const QByteArray &packed, QImage &storage) {
+	const auto width = storage.width();
+	const auto height = storage.height();
+	auto from = packed.constData();
+	const auto till = from + packed.size();
+	for (auto y = 0; y != height; ++y) {
+		auto row = reinterpret_cast<uint32*>(storage.scanLine(y));
+		auto x = 0;
+		while (x != width) {
+			auto run = Run();
+			Assert(till - from >= sizeof(run));
+			memcpy(&run, from, sizeof(run));
+			from += sizeof(run);
+
+			const auto literals = run.literals * sizeof(uint32);
+			Assert(x + run.zeros + run.literals <= width);
+			Assert(till - from >= literals);
+			memset(row + x, 0, run.zeros * sizeof(uint32));
+			x += run.zeros;
+			memcpy(row + x, from, literals);
+			from += literals;
+			x += run.literals;
+		}
+	}
+}
+
+} // namespace
+
+uint64 FrameContentHash(const QByteArray &content) {
+	return XXH64(content.constData(), content.size(), 0);
+}
+
+FrameLoop::FrameLoop(FrameLoopKey key) : _key(key) {
+}
+
+bool FrameLoop::append(const QImage &image, crl::time duration) {
+	if (image.size() != _key.size
+		|| image.format() != QImage::Format_ARGB32_Premultiplied
+		|| _frames.size() >= kMaxLoopFrames) {
+		return false;
+	}
+	auto packed = Pack(image);
+	_bytes += packed.size();
+	if (_bytes > kMaxLoopBytes) {
+		return false;
+	}
+	_frames.push_back({ std::move(packed), duration });
+	return true;
+}
+
+const FrameLoopKey &FrameLoop::key() const {
+	return _key;
+}
+
+int FrameLoop::count() const {
+	return int(_frames.size());
+}
+
+int64 FrameLoop::bytes() const {
+	return _bytes;
+}
+
+crl::time FrameLoop::duration(int index) const {
+	Expects(index >= 0 && index < _frames.size());
+
+	return _frames[index].duration;
+}
+
+QImage FrameLoop::unpack(int index, QImage storage) const {
+	Expects(index >= 0 && index < _frames.size());
+
+	if (!GoodStorageForFrame(storage, _key.size)) {
+		storage = CreateFrameStorage(_key.size);
+	}
+	Unpack(_frames[index].packed, storage);
+	return storage;
+}
+
+FrameCache &FrameCache::Instance() {
+	static auto result = FrameCache();
+	return result;
+}
+
+std::shared_ptr<const FrameLoop> FrameCache::find(
+		const FrameLoopKey &key) {
+	auto lock = std::unique_lock(_mutex);
+	const auto i = _entries.find(key);
+	if (i == end(_entries)) {
+		return nullptr;
+	}
+	i->second.lastUsed = ++_usedCounter;
+	return i->second.loop;
+}
+
+void FrameCache::put(std::shared_ptr<const FrameLoop> loop) {
+	Expects(loop != nullptr);
+
+	auto lock = std::unique_lock(_mutex);
+	const auto key = loop->key();
+	if (_entries.contains(key)) {
+		return;
+	}
+	_bytes += loop->bytes();
+	_entries.emplace(key, Entry{ std::move(loop), ++_usedCounter });
+	evictExcess();
+}
+
+void FrameCache::evictExcess() {
+	while (_bytes > kMaxCacheBytes && _entries.size() > 1) {
+		const auto i = ranges::min_element(
+			_entries,
+			ranges::less(),
+			[](const auto &pair) { return pair.second.lastUsed; });
+		_bytes -= i->second.loop->bytes();
+		_entries.erase(i);
+	}
+}
+
+} // namespace FFmpeg
@@ -0,0 +1,102 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+#include "base/flat_map.h"
+
+#include <QtGui/QImage>
+#include <memory>
+#include <mutex>
+
+namespace FFmpeg {
+
+// Identifies a loop without keeping or comparing the content itself,
+// the content hash is computed once when the generator is created.
+struct FrameLoopKey {
+	uint64 contentHash = 0;
+	int64 contentSize = 0;
+	QSize size;
+	Qt::AspectRatioMode mode = Qt::IgnoreAspectRatio;
+
+	friend inline bool operator<(
+			const FrameLoopKey &a,
+			const FrameLoopKey &b) {
+		return std::tuple(
+			a.contentHash,
+			a.contentSize,
+			a.size.width(),
+			a.size.height(),
+			int(a.mode)
+		) < std::tuple(
+			b.contentHash,
+			b.contentSize,
+			b.size.width(),
+			b.size.height(),
+			int(b.mode));
+	}
+	friend inline bool operator==(
+			const FrameLoopKey &a,
+			const FrameLoopKey &b) = default;
+};
+
+[[nodiscard]] uint64 FrameContentHash(const QByteArray &content);
+
+// Decoded frames of one loop of a short video, already scaled to the size
+// they were requested in. Frames are kept with transparent pixel runs
+// packed, so every next loop costs only an unpack instead of a decode.
+class FrameLoop final {
+public:
+	struct Frame {
+		QByteArray packed;
+		crl::time duration = 0;
+	};
+
+	explicit FrameLoop(FrameLoopKey key);
+
+	// Returns false if the loop became too large to be cached.
+	bool append(const QImage &image, crl::time duration);
+
+	[[nodiscard]] const FrameLoopKey &key() const;
+	[[nodiscard]] int count() const;
+	[[nodiscard]] int64 bytes() const;
+	[[nodiscard]] crl::time duration(int index) const;
+	[[nodiscard]] QImage unpack(int index, QImage storage) const;
+
+private:
+	const FrameLoopKey _key;
+	std::vector<Frame> _frames;
+	int64 _bytes = 0;
+
+};
+
+// Complete loops shared between all generators of the same content, so
+// that a chat with many copies of one sticker decodes its frames once.
+class FrameCache final {
+public:
+	[[nodiscard]] static FrameCache &Instance();
+
+	[[nodiscard]] std::shared_ptr<const FrameLoop> find(
+		const FrameLoopKey &key);
+	void put(std::shared_ptr<const FrameLoop> loop);
+
+private:
+	struct Entry {
+		std::shared_ptr<const FrameLoop> loop;
+		uint64 lastUsed = 0;
+	};
+
+	void evictExcess();
+
+	std::mutex _mutex;
+	base::flat_map<FrameLoopKey, Entry> _entries;
+	int64 _bytes = 0;
+	uint64 _usedCounter = 0;
+
+};
+
+} // namespace FFmpeg
@@ -7,14 +7,24 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 */
 #include "ffmpeg/ffmpeg_frame_generator.h"
 
+#include "ffmpeg/ffmpeg_frame_cache.h"
 #include "ffmpeg/ffmpeg_utility.h"
 #include "base/debug_log.h"
 
+#include <chrono>
+
 namespace FFmpeg {
 namespace {
 
 constexpr auto kMaxArea = 1920 * 1080 * 4;
 
+// Microseconds, precise enough to sum up the time of small frames.
+[[nodiscard]] crl::time Now() {
+	using namespace std::chrono;
+	return duration_cast<microseconds>(
+		steady_clock::now().time_since_epoch()).count();
+}
+
 } // namespace
 
 class FrameGenerator::Impl final {
@@ -375,10 +385,23 @@ QString FrameGenerator::Impl::wrapError(int result) const {
 }
 
 FrameGenerator::FrameGenerator(const QByteArray &bytes)
-: _impl(std::make_unique<Impl>(bytes)) {
+: _bytes(bytes)
+, _bytesHash(FrameContentHash(bytes))
+, _impl(std::make_unique<Impl>(bytes)) {
 }
 
-FrameGenerator::~FrameGenerator() = default;
+FrameGenerator::~FrameGenerator() {
+	if (_decodedCount || _cachedCount) {
+		DEBUG_LOG(("Webm Cache: %1x%2, %3 frames decoded in %4 mcs, "
+			"%5 frames from cache in %6 mcs."
+			).arg(_size.width()
+			).arg(_size.height()
+			).arg(_decodedCount
+			).arg(_decodedTime
+			).arg(_cachedCount
+			).arg(_cachedTime));
+	}
+}
 
 int FrameGenerator::count() {
 	return 0;
@@ -388,22 +411,106 @@ double FrameGenerator::rate() {
 	return 0.;
 }
 
+void FrameGenerator::switchTo(QSize size, Qt::AspectRatioMode mode) {
+	_size = size;
+	_mode = mode;
+	_recording = nullptr;
+	if (_cached) {
+		// Decoder was left somewhere in the previous loop.
+		_impl->jumpToStart();
+		_decodedIndex = 0;
+	}
+	_cached = FrameCache::Instance().find(loopKey());
+	_cachedIndex = -1;
+	startRecording();
+}
+
+void FrameGenerator::startRecording() {
+	if (!_cached && !_decodedIndex && !_size.isEmpty()) {
+		_recording = std::make_shared<FrameLoop>(loopKey());
+	}
+}
+
+FrameLoopKey FrameGenerator::loopKey() const {
+	return {
+		.contentHash = _bytesHash,
+		.contentSize = _bytes.size(),
+		.size = _size,
+		.mode = _mode,
+	};
+}
+
+void FrameGenerator::record(const Frame &frame) {
+	++_decodedIndex;
+	if (!_recording) {
+		return;
+	} else if (frame.image.isNull()
+		|| !_recording->append(frame.image, frame.duration)) {
+		_recording = nullptr;
+	} else if (frame.last) {
+		auto loop = std::shared_ptr<const FrameLoop>(base::take(_recording));
+		FrameCache::Instance().put(loop);
+		_cachedIndex = loop->count() - 1;
+		_cached = std::move(loop);
+	}
+}
+
+FrameGenerator::Frame FrameGenerator::renderCached(QImage storage) {
+	const auto started = Now();
+	const auto index = _cachedIndex;
+	auto result = Frame{
+		.duration = _cached->duration(index),
+		.image = _cached->unpack(index, std::move(storage)),
+		.last = (index + 1 == _cached->count()),
+	};
+	++_cachedCount;
+	_cachedTime += Now() - started;
+	return result;
+}
+
 FrameGenerator::Frame FrameGenerator::renderNext(
 		QImage storage,
 		QSize size,
 		Qt::AspectRatioMode mode) {
-	return _impl->renderNext(std::move(storage), size, mode);
+	if (_size != size || _mode != mode) {
+		switchTo(size, mode);
+	}
+	if (_cached) {
+		_cachedIndex = (_cachedIndex + 1) % _cached->count();
+		return renderCached(std::move(storage));
+	}
+	const auto started = Now();
+	auto result = _impl->renderNext(std::move(storage), size, mode);
+	++_decodedCount;
+	_decodedTime += Now() - started;
+	record(result);
+	return result;
 }
 
 FrameGenerator::Frame FrameGenerator::renderCurrent(
 		QImage storage,
 		QSize size,
 		Qt::AspectRatioMode mode) {
+	if (_size != size || _mode != mode) {
+		switchTo(size, mode);
+	}
+	if (_cached) {
+		_cachedIndex = std::max(_cachedIndex, 0);
+		return renderCached(std::move(storage));
+	} else if (!_decodedIndex) {
+		return renderNext(std::move(storage), size, mode);
+	}
 	return _impl->renderCurrent(std::move(storage), size, mode);
 }
 
 void FrameGenerator::jumpToStart() {
+	if (_cached) {
+		_cachedIndex = -1;
+		return;
+	}
 	_impl->jumpToStart();
+	_decodedIndex = 0;
+	startRecording();
 }
 
 } // namespace FFmpeg
@@ -14,6 +14,9 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 
 namespace FFmpeg {
 
+class FrameLoop;
+struct FrameLoopKey;
+
 class FrameGenerator final : public Ui::FrameGenerator {
 public:
 	explicit FrameGenerator(const QByteArray &bytes);
@@ -34,8 +37,29 @@ public:
 private:
 	class Impl;
 
+	void switchTo(QSize size, Qt::AspectRatioMode mode);
+	void startRecording();
+	void record(const Frame &frame);
+	[[nodiscard]] Frame renderCached(QImage storage);
+	[[nodiscard]] FrameLoopKey loopKey() const;
+
+	const QByteArray _bytes;
+	const uint64 _bytesHash = 0;
 	std::unique_ptr<Impl> _impl;
 
+	// After the first loop is decoded, frames are taken from the cache.
+	std::shared_ptr<const FrameLoop> _cached;
+	std::shared_ptr<FrameLoop> _recording;
+	QSize _size;
+	Qt::AspectRatioMode _mode = Qt::IgnoreAspectRatio;
+	int _cachedIndex = -1;
+	int _decodedIndex = 0;
+
+	int _decodedCount = 0;
+	int _cachedCount = 0;
+	crl::time _decodedTime = 0;
+	crl::time _cachedTime = 0;
+
 };
 
 } // namespace FFmpeg
@@ -15,6 +15,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "history/history_item.h"
 #include "history/history_item_components.h"
 #include "history/history_item_helpers.h"
+#include "history/history_loaded_windows.h"
 #include "history/history_translation.h"
 #include "history/history_unread_things.h"
 #include "dialogs/ui/dialogs_layout.h"
@@ -1446,6 +1447,78 @@ void History::addNewerSlice(const QVector<MTPMessage> &slice) {
 	checkLastMessage();
 }
 
+bool History::addOlderSliceFromLoadedWindows(int limit) {
+	if (!_loadedWindows
+		|| isEmpty()
+		|| loadedAtTop()
+		|| isBuildingFrontBlock()) {
+		return false;
+	}
+	const auto items = collectUnloaded(
+		_loadedWindows->before(minMsgId(), limit));
+	if (items.empty()) {
+		return false;
+	}
+	addCreatedOlderSlice(items);
+	checkLocalMessages();
+	checkLastMessage();
+	return true;
+}
+
+bool History::addNewerSliceFromLoadedWindows(int limit) {
+	if (!_loadedWindows || isEmpty() || loadedAtBottom()) {
+		return false;
+	}
+	const auto items = collectUnloaded(
+		_loadedWindows->after(maxMsgId(), limit));
+	if (items.empty()) {
+		return false;
+	}
+	for (const auto &item : items) {
+		addItemToBlock(item);
+	}
+	addToSharedMedia(items);
+	checkLocalMessages();
+	checkLastMessage();
+	return true;
+}
+
+std::vector<not_null<HistoryItem*>> History::collectUnloaded(
+		const std::vector<MsgId> &ids) {
+	auto result = std::vector<not_null<HistoryItem*>>();
+	result.reserve(ids.size());
+	for (const auto id : ids) {
+		// Deleted messages just disappear from the window.
+		const auto item = owner().message(peer, id);
+		if (item && item->history() == this && !item->mainView()) {
+			result.push_back(item);
+		}
+	}
+	return result;
+}
+
+void History::rememberLoadedWindow() {
+	auto ids = std::vector<MsgId>();
+	for (const auto &block : blocks) {
+		for (const auto &message : block->messages) {
+			const auto item = message->data();
+			if (item->isRegular()) {
+				ids.push_back(item->id);
+			}
+		}
+	}
+	if (ids.empty()) {
+		return;
+	} else if (!_loadedWindows) {
+		_loadedWindows = std::make_unique<HistoryLoadedWindows>();
+	}
+	_loadedWindows->add(std::move(ids), maxMsgId());
+}
+
+void History::forgetLoadedWindows() {
+	_loadedWindows = nullptr;
+}
+
 void History::checkLastMessage() {
 	if (const auto last = lastMessage()) {
 		if (!_loadedAtBottom && last->mainView()) {
@@ -2302,7 +2375,10 @@ const base::flat_set<QChar> &History::chatListFirstLetters() const {
 
 void History::chatListPreloadData() {
 	peer->loadUserpic();
-	allowChatListMessageResolve();
+	if (!_localPreview) {
+		// The server dialogs will bring the last message soon.
+		allowChatListMessageResolve();
+	}
 }
 
 void History::paintUserpic(
@@ -2402,6 +2478,7 @@ void History::getReadyFor(MsgId msgId) {
 		}
 	}
 	if (!isReadyFor(msgId)) {
+		rememberLoadedWindow();
 		clear(ClearType::Unload);
 		if (const auto migratePeer = peer->migrateFrom()) {
 			if (const auto migrated = owner().historyLoaded(migratePeer)) {
@@ -2446,6 +2523,7 @@ void History::setLastMessage(HistoryItem *item) {
 	if (!item || item->isRegular()) {
 		_lastServerMessage = item;
 	}
+	clearLocalPreview();
 	if (peer->migrateTo()) {
 		// We don't want to request last message for all deactivated chats.
 		// This is a heavy request for them, because we need to get last
@@ -2945,6 +3023,26 @@ void History::applyDialogTopMessage(MsgId topMessageId) {
 	}
 }
 
+void History::setLocalPreview(HistoryLocalPreview &&preview) {
+	Expects(!lastMessageKnown());
+
+	const auto date = preview.date;
+	_localPreview = std::make_unique<HistoryLocalPreview>(
+		std::move(preview));
+	setChatListTimeId(date);
+	updateChatListEntry();
+}
+
+void History::clearLocalPreview() {
+	if (base::take(_localPreview)) {
+		updateChatListEntry();
+	}
+}
+
+HistoryLocalPreview *History::localPreview() const {
+	return _localPreview.get();
+}
+
 void History::setInboxReadTill(MsgId upTo) {
 	if (_inboxReadBefore) {
 		accumulate_max(*_inboxReadBefore, upTo + 1);
@@ -3368,6 +3466,7 @@ void History::clear(ClearType type) {
 	if (type == ClearType::Unload) {
 		_loadedAtTop = _loadedAtBottom = false;
 	} else {
+		forgetLoadedWindows();
 		// Leave the 'sending' messages in local messages.
 		auto local = base::flat_set<not_null<HistoryItem*>>();
 		for (const auto &item : _clientSideMessages) {
@@ -19,6 +19,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 class History;
 class HistoryBlock;
 class HistoryTranslation;
+class HistoryLoadedWindows;
 class HistoryItem;
 struct HistoryMessageMarkupData;
 class HistoryMainElementDelegateMixin;
@@ -75,6 +76,16 @@ enum class NewMessageType {
 	Existing,
 };
 
+// Last message preview from the local chats list snapshot. It is shown in
+// the chats list until the last message is known, it is not a message.
+struct HistoryLocalPreview {
+	TimeId date = 0;
+	QString sender;
+	TextWithEntities text;
+	bool service = false;
+	Ui::Text::String cache;
+};
+
 class History final : public Data::Thread {
 public:
 	using Element = HistoryView::Element;
@@ -213,6 +224,11 @@ public:
 	void addOlderSlice(const QVector<MTPMessage> &slice);
 	void addNewerSlice(const QVector<MTPMessage> &slice);
 
+	// Put back previously unloaded messages without a server request.
+	bool addOlderSliceFromLoadedWindows(int limit);
+	bool addNewerSliceFromLoadedWindows(int limit);
+	void forgetLoadedWindows();
+
 	void newItemAdded(not_null<HistoryItem*> item);
 
 	void registerClientSideMessage(not_null<HistoryItem*> item);
@@ -269,6 +285,9 @@ public:
 	[[nodiscard]] bool lastServerMessageKnown() const;
 	void unknownMessageDeleted(MsgId messageId);
 	void applyDialogTopMessage(MsgId topMessageId);
+	void setLocalPreview(HistoryLocalPreview &&preview);
+	void clearLocalPreview();
+	[[nodiscard]] HistoryLocalPreview *localPreview() const;
 	void applyDialog(Data::Folder *requestFolder, const MTPDdialog &data);
 	void applyPinnedUpdate(const MTPDupdateDialogPinned &data);
 	void applyDialogFields(
@@ -523,6 +542,9 @@ private:
 
 	void addCreatedOlderSlice(
 		const std::vector<not_null<HistoryItem*>> &items);
+	void rememberLoadedWindow();
+	[[nodiscard]] std::vector<not_null<HistoryItem*>> collectUnloaded(
+		const std::vector<MsgId> &ids);
 
 	void checkForLoadedAtTop(not_null<HistoryItem*> added);
 	void mainViewRemoved(
@@ -617,6 +639,7 @@ private:
 	// for a group that migrated to a supergroup. Then _lastMessage can
 	// be a migrate message, but _chatListMessage should be the one before.
 	std::optional<HistoryItem*> _chatListMessage;
+	std::unique_ptr<HistoryLocalPreview> _localPreview;
 
 	QString _chatListNameSortKey;
 
@@ -629,6 +652,7 @@ private:
 	};
 	std::unique_ptr<BuildingBlock> _buildingFrontBlock;
 	std::unique_ptr<HistoryTranslation> _translation;
+	std::unique_ptr<HistoryLoadedWindows> _loadedWindows;
 
 	Data::HistoryDrafts _drafts;
 	base::flat_map<MsgId, TimeId> _acceptCloudDraftsAfter;
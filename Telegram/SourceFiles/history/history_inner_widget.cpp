@@ -698,6 +698,12 @@ void HistoryInner::messagesReceivedDown(
 	}
 }
 
+void HistoryInner::messagesRestored(not_null<History*> history) {
+	if (history == _history) {
+		_translateTracker->addBunchFromBlocks();
+	}
+}
+
 void HistoryInner::repaintItem(const HistoryItem *item) {
 	if (const auto view = viewByItem(item)) {
 		repaintItem(view);
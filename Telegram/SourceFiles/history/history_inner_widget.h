@@ -107,6 +107,7 @@ public:
 	void messagesReceivedDown(
 		not_null<PeerData*> peer,
 		const QVector<MTPMessage> &messages);
+	void messagesRestored(not_null<History*> history);
 
 	[[nodiscard]] TextForMimeData getSelectedText() const;
 
@@ -0,0 +1,111 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "history/history_load_planner.h"
+
+namespace {
+
+constexpr auto kMessagesPerPage = 50;
+constexpr auto kMaxMessagesPerPage = 100; // Server side limit.
+constexpr auto kPreloadHeightsCount = 3;
+constexpr auto kMaxPreloadHeightsCount = 12;
+constexpr auto kTargetHorizon = crl::time(1500);
+constexpr auto kDefaultRoundTrip = crl::time(300);
+constexpr auto kVelocityResetTimeout = crl::time(300);
+constexpr auto kSmoothingFactor = 0.3;
+
+[[nodiscard]] float64 Smooth(float64 was, float64 now) {
+	return was * (1. - kSmoothingFactor) + now * kSmoothingFactor;
+}
+
+} // namespace
+
+void HistoryLoadPlanner::reset() {
+	*this = HistoryLoadPlanner();
+}
+
+void HistoryLoadPlanner::scrolled(
+		int scrollTop,
+		int scrollHeight,
+		crl::time now) {
+	const auto delta = std::abs(scrollTop - _lastScrollTop);
+	const auto elapsed = now - _lastScrollTime;
+	_lastScrollTop = scrollTop;
+	_lastScrollTime = now;
+	if (elapsed <= 0) {
+		return;
+	} else if (elapsed > kVelocityResetTimeout) {
+		_velocity = 0.;
+		return;
+	} else if (delta > 2 * scrollHeight) {
+		// Content was added above or the scroll was jumped somewhere.
+		return;
+	}
+	_velocity = Smooth(_velocity, delta * 1000. / elapsed);
+}
+
+void HistoryLoadPlanner::measured(int contentHeight, int itemsCount) {
+	if (contentHeight <= 0 || itemsCount <= 0) {
+		return;
+	}
+	_averageItemHeight = std::max(contentHeight / itemsCount, 1);
+}
+
+auto HistoryLoadPlanner::request(bool older) -> Request & {
+	return older ? _older : _newer;
+}
+
+void HistoryLoadPlanner::requestStarted(bool older, crl::time now) {
+	request(older) = Request{ .started = now };
+}
+
+void HistoryLoadPlanner::requestFinished(bool older, crl::time now) {
+	const auto finished = std::exchange(request(older), Request());
+	if (!finished.started) {
+		return;
+	}
+	const auto duration = now - finished.started;
+	_roundTrip = _roundTrip
+		? crl::time(Smooth(_roundTrip, duration))
+		: duration;
+	if (finished.stalled) {
+		DEBUG_LOG(("History Load: Stall #%1 %2 for %3 ms, "
+			"velocity %4, round trip %5, item height %6."
+			).arg(_stallsCount
+			).arg(older ? "up" : "down"
+			).arg(now - finished.stalled
+			).arg(int(_velocity)
+			).arg(_roundTrip
+			).arg(_averageItemHeight));
+	}
+}
+
+void HistoryLoadPlanner::stalled(bool older, crl::time now) {
+	auto &stalled = request(older);
+	if (stalled.started && !stalled.stalled) {
+		stalled.stalled = now;
+		++_stallsCount;
+	}
+}
+
+int HistoryLoadPlanner::preloadDistance(int scrollHeight) const {
+	const auto minimal = kPreloadHeightsCount * scrollHeight;
+	const auto maximal = kMaxPreloadHeightsCount * scrollHeight;
+	const auto roundTrip = _roundTrip ? _roundTrip : kDefaultRoundTrip;
+	const auto required = int(base::SafeRound(
+		_velocity * (roundTrip + kTargetHorizon) / 1000.));
+	return std::clamp(required, minimal, maximal);
+}
+
+int HistoryLoadPlanner::messagesPerPage(int scrollHeight) const {
+	if (!_averageItemHeight) {
+		return kMessagesPerPage;
+	}
+	const auto cover = preloadDistance(scrollHeight) + scrollHeight;
+	const auto count = (cover + _averageItemHeight - 1) / _averageItemHeight;
+	return std::clamp(count, kMessagesPerPage, kMaxMessagesPerPage);
+}
@@ -0,0 +1,48 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+// Chooses how many messages to request and how early to start a preload
+// request, so that the already loaded part of the history lasts for the
+// current scroll speed while the next slice is being loaded.
+class HistoryLoadPlanner final {
+public:
+	void reset();
+
+	void scrolled(int scrollTop, int scrollHeight, crl::time now);
+	void measured(int contentHeight, int itemsCount);
+	void requestStarted(bool older, crl::time now);
+	void requestFinished(bool older, crl::time now);
+
+	// Scrolled to the edge while the request for that side is not done.
+	void stalled(bool older, crl::time now);
+
+	[[nodiscard]] int preloadDistance(int scrollHeight) const;
+	[[nodiscard]] int messagesPerPage(int scrollHeight) const;
+
+private:
+	struct Request {
+		crl::time started = 0;
+		crl::time stalled = 0;
+	};
+
+	[[nodiscard]] Request &request(bool older);
+
+	Request _older;
+	Request _newer;
+	int _averageItemHeight = 0;
+	crl::time _roundTrip = 0;
+	crl::time _lastScrollTime = 0;
+	int _lastScrollTop = 0;
+
+	// Pixels per second.
+	float64 _velocity = 0.;
+
+	int _stallsCount = 0;
+
+};
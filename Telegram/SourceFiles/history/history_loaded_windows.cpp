@@ -0,0 +1,103 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "history/history_loaded_windows.h"
+
+namespace {
+
+constexpr auto kMaxWindows = 8;
+constexpr auto kMaxIdsInWindows = 20'000;
+
+[[nodiscard]] MsgId Distance(
+		const std::vector<MsgId> &window,
+		MsgId aroundId) {
+	return (aroundId < window.front())
+		? (window.front() - aroundId)
+		: (aroundId > window.back())
+		? (aroundId - window.back())
+		: MsgId(0);
+}
+
+} // namespace
+
+void HistoryLoadedWindows::add(std::vector<MsgId> ids, MsgId aroundId) {
+	if (ids.empty()) {
+		return;
+	}
+	ranges::sort(ids);
+
+	// Slices that overlap are both contiguous, so their union is as well.
+	for (auto i = begin(_windows); i != end(_windows);) {
+		if (i->front() <= ids.back() && ids.front() <= i->back()) {
+			auto merged = Window();
+			merged.reserve(ids.size() + i->size());
+			ranges::set_union(ids, *i, std::back_inserter(merged));
+			ids = std::move(merged);
+			i = _windows.erase(i);
+		} else {
+			++i;
+		}
+	}
+	const auto i = ranges::lower_bound(
+		_windows,
+		ids.front(),
+		ranges::less(),
+		[](const Window &window) { return window.front(); });
+	_windows.insert(i, std::move(ids));
+	evictFarFrom(aroundId);
+}
+
+auto HistoryLoadedWindows::find(MsgId id) const -> const Window* {
+	for (const auto &window : _windows) {
+		if (window.front() <= id && id <= window.back()) {
+			return &window;
+		}
+	}
+	return nullptr;
+}
+
+std::vector<MsgId> HistoryLoadedWindows::before(MsgId id, int limit) const {
+	const auto window = find(id);
+	if (!window) {
+		return {};
+	}
+	const auto till = ranges::lower_bound(*window, id);
+	const auto from = (till - begin(*window) > limit)
+		? (till - limit)
+		: begin(*window);
+	return { from, till };
+}
+
+std::vector<MsgId> HistoryLoadedWindows::after(MsgId id, int limit) const {
+	const auto window = find(id);
+	if (!window) {
+		return {};
+	}
+	const auto from = ranges::upper_bound(*window, id);
+	const auto till = (end(*window) - from > limit)
+		? (from + limit)
+		: end(*window);
+	return { from, till };
+}
+
+void HistoryLoadedWindows::evictFarFrom(MsgId aroundId) {
+	const auto total = [&] {
+		auto result = 0;
+		for (const auto &window : _windows) {
+			result += int(window.size());
+		}
+		return result;
+	};
+	while (_windows.size() > 1
+		&& (_windows.size() > kMaxWindows || total() > kMaxIdsInWindows)) {
+		const auto farthest = ranges::max_element(
+			_windows,
+			ranges::less(),
+			[&](const Window &window) { return Distance(window, aroundId); });
+		_windows.erase(farthest);
+	}
+}
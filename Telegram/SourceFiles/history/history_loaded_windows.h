@@ -0,0 +1,30 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+// Disjoint slices of server message ids that were once loaded into the
+// History blocks contiguously and then unloaded (for example when jumping
+// to an old message). The items themselves stay in History::_messages,
+// so such a slice can be put back into the blocks without a request.
+class HistoryLoadedWindows final {
+public:
+	void add(std::vector<MsgId> ids, MsgId aroundId);
+
+	// Ids from the window containing 'id', strictly before / after it.
+	[[nodiscard]] std::vector<MsgId> before(MsgId id, int limit) const;
+	[[nodiscard]] std::vector<MsgId> after(MsgId id, int limit) const;
+
+private:
+	using Window = std::vector<MsgId>;
+
+	[[nodiscard]] const Window *find(MsgId id) const;
+	void evictFarFrom(MsgId aroundId);
+
+	std::vector<Window> _windows;
+
+};
@@ -81,6 +81,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "history/history_item_helpers.h" // GetErrorTextForSending.
 #include "history/history_drag_area.h"
 #include "history/history_inner_widget.h"
+#include "history/history_load_planner.h"
 #include "history/history_item_components.h"
 #include "history/history_unread_things.h"
 #include "history/view/controls/history_view_compose_search.h"
@@ -176,7 +177,6 @@ namespace {
 
 constexpr auto kMessagesPerPageFirst = 30;
 constexpr auto kMessagesPerPage = 50;
-constexpr auto kPreloadHeightsCount = 3; // when 3 screens to scroll left make a preload request
 constexpr auto kScrollToVoiceAfterScrolledMs = 1000;
 constexpr auto kSkipRepaintWhileScrollMs = 100;
 constexpr auto kShowMembersDropdownTimeoutMs = 300;
@@ -201,6 +201,16 @@ const auto kPsaAboutPrefix = "cloud_lng_about_psa_";
 	});
 }
 
+[[nodiscard]] int LoadedMessagesCount(History *history) {
+	auto result = 0;
+	if (history) {
+		for (const auto &block : history->blocks) {
+			result += int(block->messages.size());
+		}
+	}
+	return result;
+}
+
 } // namespace
 
 HistoryWidget::HistoryWidget(
@@ -252,6 +262,7 @@ HistoryWidget::HistoryWidget(
 	_send,
 	st::historySendSize.height()))
 , _forwardPanel(std::make_unique<ForwardPanel>([=] { updateField(); }))
+, _loadPlanner(std::make_unique<HistoryLoadPlanner>())
 , _field(
 	this,
 	st::historyComposeField,
@@ -995,6 +1006,7 @@ void HistoryWidget::initVoiceRecordBar() {
 	_voiceRecordBar->sendVoiceRequests(
 	) | rpl::start_with_next([=](const auto &data) {
 		if (!canWriteMessage() || data.bytes.isEmpty() || !_history) {
+			session().uploader().streamCancel(data.uploadId);
 			return;
 		}
 
@@ -1003,7 +1015,8 @@ void HistoryWidget::initVoiceRecordBar() {
 			data.bytes,
 			data.waveform,
 			data.duration,
-			action);
+			action,
+			data.uploadId);
 		_voiceRecordBar->clearListenState();
 	}, lifetime());
 
@@ -2146,6 +2159,8 @@ void HistoryWidget::showHistory(
 	_showAtMsgId = showAtMsgId;
 	_historyInited = false;
 	_contactStatus = nullptr;
+	_loadPlanner->reset();
+	_loadPlannerMeasuredHeight = 0;
 
 	if (peerId) {
 		_peer = session().data().peer(peerId);
@@ -3358,8 +3373,11 @@ void HistoryWidget::loadMessages() {
 	const auto offsetId = from->minMsgId();
 	const auto addOffset = 0;
 	const auto loadCount = offsetId
-		? kMessagesPerPage
+		? _loadPlanner->messagesPerPage(_scroll->height())
 		: kMessagesPerPageFirst;
+	if (addMessagesFromLoadedWindows(from, true)) {
+		return;
+	}
 	const auto offsetDate = 0;
 	const auto maxId = 0;
 	const auto minId = 0;
@@ -3375,6 +3393,7 @@ void HistoryWidget::loadMessages() {
 	const auto type = Data::Histories::RequestType::History;
 	auto &histories = history->owner().histories();
 	_preloadRequest = histories.sendRequest(history, type, [=](Fn<void()> finish) {
+		_loadPlanner->requestStarted(true, crl::now());
 		return history->session().api().request(MTPmessages_GetHistory(
 			history->peer->input,
 			MTP_int(offsetId),
@@ -3385,9 +3404,11 @@ void HistoryWidget::loadMessages() {
 			MTP_int(minId),
 			MTP_long(historyHash)
 		)).done([=](const MTPmessages_Messages &result) {
+			_loadPlanner->requestFinished(true, crl::now());
 			messagesReceived(history->peer, result, _preloadRequest);
 			finish();
 		}).fail([=](const MTP::Error &error) {
+			_loadPlanner->requestFinished(true, crl::now());
 			messagesFailed(error, _preloadRequest);
 			finish();
 		}).send();
@@ -3412,7 +3433,11 @@ void HistoryWidget::loadMessagesDown() {
 		return;
 	}
 
-	const auto loadCount = kMessagesPerPage;
+	if (addMessagesFromLoadedWindows(from, false)) {
+		return;
+	}
+
+	const auto loadCount = _loadPlanner->messagesPerPage(_scroll->height());
 	auto addOffset = -loadCount;
 	auto offsetId = from->maxMsgId();
 	if (!offsetId) {
@@ -3435,6 +3460,7 @@ void HistoryWidget::loadMessagesDown() {
 	const auto type = Data::Histories::RequestType::History;
 	auto &histories = history->owner().histories();
 	_preloadDownRequest = histories.sendRequest(history, type, [=](Fn<void()> finish) {
+		_loadPlanner->requestStarted(false, crl::now());
 		return history->session().api().request(MTPmessages_GetHistory(
 			history->peer->input,
 			MTP_int(offsetId + 1),
@@ -3445,9 +3471,11 @@ void HistoryWidget::loadMessagesDown() {
 			MTP_int(minId),
 			MTP_long(historyHash)
 		)).done([=](const MTPmessages_Messages &result) {
+			_loadPlanner->requestFinished(false, crl::now());
 			messagesReceived(history->peer, result, _preloadDownRequest);
 			finish();
 		}).fail([=](const MTP::Error &error) {
+			_loadPlanner->requestFinished(false, crl::now());
 			messagesFailed(error, _preloadDownRequest);
 			finish();
 		}).send();
@@ -3601,11 +3629,26 @@ void HistoryWidget::preloadHistoryByScroll() {
 	auto scrollTop = _scroll->scrollTop();
 	auto scrollTopMax = _scroll->scrollTopMax();
 	auto scrollHeight = _scroll->height();
-	if (scrollTop + kPreloadHeightsCount * scrollHeight >= scrollTopMax) {
+	const auto now = crl::now();
+	_loadPlanner->scrolled(scrollTop, scrollHeight, now);
+	if (_loadPlannerMeasuredHeight != _list->height()) {
+		_loadPlannerMeasuredHeight = _list->height();
+		_loadPlanner->measured(
+			_loadPlannerMeasuredHeight,
+			LoadedMessagesCount(_history) + LoadedMessagesCount(_migrated));
+	}
+	const auto preloadDistance = _loadPlanner->preloadDistance(scrollHeight);
+	if (scrollTop + preloadDistance >= scrollTopMax) {
 		loadMessagesDown();
+		if (scrollTop >= scrollTopMax && _preloadDownRequest) {
+			_loadPlanner->stalled(false, now);
+		}
 	}
-	if (scrollTop <= kPreloadHeightsCount * scrollHeight) {
+	if (scrollTop <= preloadDistance) {
 		loadMessages();
+		if (scrollTop <= 0 && _preloadRequest) {
+			_loadPlanner->stalled(true, now);
+		}
 	}
 	if (session().supportMode()) {
 		crl::on_main(this, [=] { checkSupportPreload(); });
@@ -5926,6 +5969,45 @@ void HistoryWidget::addMessagesToBack(
 	injectSponsoredMessages();
 }
 
+bool HistoryWidget::addMessagesFromLoadedWindows(
+		not_null<History*> from,
+		bool older) {
+	if (older) {
+		const auto count = _loadPlanner->messagesPerPage(_scroll->height());
+		if (!from->addOlderSliceFromLoadedWindows(count)) {
+			return false;
+		}
+		_list->messagesRestored(from);
+		updateHistoryGeometry();
+		updateBotKeyboard();
+	} else {
+		const auto checkForUnreadStart = [&] {
+			if (_history->unreadBar() || !_history->trackUnreadMessages()) {
+				return false;
+			}
+			_history->calculateFirstUnreadMessage();
+			return !_history->firstUnreadMessage();
+		}();
+		const auto count = _loadPlanner->messagesPerPage(_scroll->height());
+		if (!from->addNewerSliceFromLoadedWindows(count)) {
+			return false;
+		}
+		if (checkForUnreadStart) {
+			_history->calculateFirstUnreadMessage();
+			createUnreadBarAndResize();
+		}
+		updateHistoryGeometry(false, true, { ScrollChangeNoJumpToBottom, 0 });
+		injectSponsoredMessages();
+	}
+	DEBUG_LOG(("LoadedWindows(%1): Restored %2 messages."
+		).arg(_history->peer->name()
+		).arg(older ? "older" : "newer"));
+
+	// Continue preloading the same way as after a server response.
+	crl::on_main(this, [=] { preloadHistoryIfNeeded(); });
+	return true;
+}
+
 void HistoryWidget::updateBotKeyboard(History *h, bool force) {
 	if (h && h != _history && h != _migrated) {
 		return;
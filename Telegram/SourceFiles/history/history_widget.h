@@ -104,6 +104,7 @@ class TTLButton;
 
 class BotKeyboard;
 class HistoryInner;
+class HistoryLoadPlanner;
 
 class HistoryWidget final
 	: public Window::AbstractSectionWidget
@@ -542,6 +543,7 @@ private:
 	void messagesFailed(const MTP::Error &error, int requestId);
 	void addMessagesToFront(not_null<PeerData*> peer, const QVector<MTPMessage> &messages);
 	void addMessagesToBack(not_null<PeerData*> peer, const QVector<MTPMessage> &messages);
+	bool addMessagesFromLoadedWindows(not_null<History*> from, bool older);
 
 	void updateHistoryGeometry(bool initial = false, bool loadedDown = false, const ScrollChange &change = { ScrollChangeNone, 0 });
 	void updateListSize();
@@ -691,6 +693,8 @@ private:
 	int _firstLoadRequest = 0; // Not real mtpRequestId.
 	int _preloadRequest = 0; // Not real mtpRequestId.
 	int _preloadDownRequest = 0; // Not real mtpRequestId.
+	const std::unique_ptr<HistoryLoadPlanner> _loadPlanner;
+	int _loadPlannerMeasuredHeight = 0;
 
 	MsgId _delayedShowAtMsgId = -1;
 	int _delayedShowAtRequest = 0; // Not real mtpRequestId.
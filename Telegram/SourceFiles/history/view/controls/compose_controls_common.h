@@ -27,6 +27,7 @@ struct VoiceToSend {
 	VoiceWaveform waveform;
 	int duration = 0;
 	Api::SendOptions options;
+	uint64 uploadId = 0; // Parts uploaded while recording, if non-zero.
 };
 struct SendActionUpdate {
 	Api::SendProgressType type = Api::SendProgressType();
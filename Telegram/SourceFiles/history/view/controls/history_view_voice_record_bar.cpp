@@ -26,6 +26,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "media/audio/media_audio_capture.h"
 #include "media/player/media_player_button.h"
 #include "media/player/media_player_instance.h"
+#include "storage/file_upload.h"
 #include "styles/style_chat.h"
 #include "styles/style_layers.h"
 #include "styles/style_media_player.h"
@@ -1026,6 +1027,7 @@ VoiceRecordBar::~VoiceRecordBar() {
 	if (isRecording()) {
 		stopRecording(StopType::Cancel);
 	}
+	cancelUpload();
 }
 
 void VoiceRecordBar::updateMessageGeometry() {
@@ -1327,6 +1329,7 @@ void VoiceRecordBar::startRecording() {
 		_recording = true;
 		_controller->widget()->setInnerFocus();
 		instance()->start();
+		startUpload();
 		instance()->updated(
 		) | rpl::start_with_next_error([=](const Update &update) {
 			_recordingTipRequired = (update.samples < kMinSamples);
@@ -1419,15 +1422,39 @@ void VoiceRecordBar::hideFast() {
 	_level->hide();
 }
 
+void VoiceRecordBar::startUpload() {
+	using namespace ::Media::Capture;
+
+	cancelUpload();
+	_uploadId = _controller->session().uploader().streamStart();
+	instance()->encoded(
+	) | rpl::start_with_next([=](const Chunk &chunk) {
+		_controller->session().uploader().streamAppend(
+			_uploadId,
+			chunk.offset,
+			chunk.bytes);
+	}, _recordingLifetime);
+}
+
+void VoiceRecordBar::cancelUpload() {
+	if (const auto id = base::take(_uploadId)) {
+		_controller->session().uploader().streamCancel(id);
+	}
+}
+
 void VoiceRecordBar::stopRecording(StopType type) {
 	using namespace ::Media::Capture;
 	if (type == StopType::Cancel) {
+		cancelUpload();
 		instance()->stop(crl::guard(this, [=](Result &&data) {
 			_cancelRequests.fire({});
 		}));
 		return;
 	}
 	instance()->stop(crl::guard(this, [=](Result &&data) {
+		if (!data.streamed) {
+			cancelUpload();
+		}
 		if (data.bytes.isEmpty()) {
 			// Close everything.
 			stop(false);
@@ -1437,7 +1464,12 @@ void VoiceRecordBar::stopRecording(StopType type) {
 		Window::ActivateWindow(_controller);
 		const auto duration = Duration(data.samples);
 		if (type == StopType::Send) {
-			_sendVoiceRequests.fire({ data.bytes, data.waveform, duration });
+			_sendVoiceRequests.fire({
+				.bytes = data.bytes,
+				.waveform = data.waveform,
+				.duration = duration,
+				.uploadId = base::take(_uploadId),
+			});
 		} else if (type == StopType::Listen) {
 			_listen = std::make_unique<ListenWrap>(
 				this,
@@ -1514,7 +1546,8 @@ void VoiceRecordBar::requestToSendWithOptions(Api::SendOptions options) {
 			data->bytes,
 			data->waveform,
 			Duration(data->samples),
-			options });
+			options,
+			base::take(_uploadId) });
 	}
 }
 
@@ -121,6 +121,9 @@ private:
 
 	void computeAndSetLockProgress(QPoint globalPos);
 
+	void startUpload();
+	void cancelUpload();
+
 	const not_null<Ui::RpWidget*> _sectionWidget;
 	const not_null<Window::SessionController*> _controller;
 	const std::shared_ptr<Ui::SendButton> _send;
@@ -128,6 +131,7 @@ private:
 	const std::unique_ptr<VoiceRecordButton> _level;
 	const std::unique_ptr<CancelButton> _cancel;
 	std::unique_ptr<ListenWrap> _listen;
+	uint64 _uploadId = 0;
 
 	base::Timer _startTimer;
 
@@ -68,6 +68,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "main/main_session_settings.h"
 #include "mainwidget.h"
 #include "data/data_session.h"
+#include "data/data_histories.h"
 #include "data/data_user.h"
 #include "data/data_chat.h"
 #include "data/data_channel.h"
@@ -177,7 +178,7 @@ void RepliesMemento::setReadInformation(
 			}
 		}
 		if (!_replies) {
-			_replies = std::make_shared<Data::RepliesList>(
+			_replies = _history->owner().histories().repliesList(
 				_history,
 				_rootId);
 		}
@@ -1158,7 +1159,8 @@ void RepliesWidget::sendVoice(ComposeControls::VoiceToSend &&data) {
 		data.bytes,
 		data.waveform,
 		data.duration,
-		std::move(action));
+		std::move(action),
+		data.uploadId);
 
 	_composeControls->cancelReplyMessage();
 	_composeControls->clearListenState();
@@ -2078,7 +2080,7 @@ void RepliesWidget::refreshReplies() {
 	auto old = base::take(_replies);
 	setReplies(_topic
 		? _topic->replies()
-		: std::make_shared<Data::RepliesList>(_history, _rootId));
+		: _history->owner().histories().repliesList(_history, _rootId));
 	if (old) {
 		_inner->refreshViewer();
 	}
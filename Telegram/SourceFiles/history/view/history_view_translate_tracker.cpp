@@ -20,6 +20,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "history/view/history_view_element.h"
 #include "main/main_session.h"
 #include "spellcheck/platform/platform_language.h"
+#include "storage/cache/storage_cache_database.h"
 
 namespace HistoryView {
 namespace {
@@ -30,6 +31,48 @@ constexpr auto kMaxCheckInBunch = 100;
 constexpr auto kRequestLengthLimit = 24 * 1024;
 constexpr auto kRequestCountLimit = 20;
 
+[[nodiscard]] Storage::Cache::Key CacheKey(
+		not_null<HistoryItem*> item,
+		LanguageId to) {
+	const auto edited = item->Get<HistoryMessageEdited>();
+	return Data::TranslationCacheKey(
+		item->fullId(),
+		edited ? edited->date : TimeId(0),
+		to.twoLetterCode());
+}
+
+[[nodiscard]] QByteArray Serialize(const MTPTextWithEntities &text) {
+	auto buffer = mtpBuffer();
+	text.write(buffer);
+	return QByteArray(
+		reinterpret_cast<const char*>(buffer.constData()),
+		buffer.size() * sizeof(mtpPrime));
+}
+
+[[nodiscard]] std::optional<MTPTextWithEntities> Deserialize(
+		const QByteArray &value) {
+	if (value.isEmpty() || (value.size() % sizeof(mtpPrime))) {
+		return std::nullopt;
+	}
+	auto result = MTPTextWithEntities();
+	auto from = reinterpret_cast<const mtpPrime*>(value.constData());
+	const auto till = from + (value.size() / sizeof(mtpPrime));
+	if (!result.read(from, till)) {
+		return std::nullopt;
+	}
+	return result;
+}
+
+[[nodiscard]] TextWithEntities Parse(
+		not_null<Main::Session*> session,
+		const MTPTextWithEntities &text) {
+	const auto &data = text.data();
+	return {
+		qs(data.vtext()),
+		Api::EntitiesFromMTP(session, data.ventities().v)
+	};
+}
+
 } // namespace
 
 TranslateTracker::TranslateTracker(not_null<History*> history)
@@ -149,9 +192,46 @@ void TranslateTracker::switchTranslation(
 		not_null<HistoryItem*> item,
 		LanguageId id) {
 	if (item->translationShowRequiresRequest(id)) {
-		_itemsToRequest.emplace(
-			item->fullId(),
-			ItemToRequest{ int(item->originalText().text.size()) });
+		checkCached(item, id);
+	}
+}
+
+void TranslateTracker::checkCached(
+		not_null<HistoryItem*> item,
+		LanguageId to) {
+	const auto id = item->fullId();
+	const auto entry = ItemToRequest{ int(item->originalText().text.size()) };
+	const auto weak = base::make_weak(this);
+	_itemsCheckingCache.emplace(id);
+	_history->owner().cache().get(CacheKey(item, to), [=](
+			QByteArray &&value) {
+		crl::on_main(weak, [=, value = std::move(value)]() mutable {
+			checkCachedDone(id, to, entry, std::move(value));
+		});
+	});
+}
+
+void TranslateTracker::checkCachedDone(
+		FullMsgId id,
+		LanguageId to,
+		ItemToRequest entry,
+		QByteArray value) {
+	if (!_itemsCheckingCache.remove(id)) {
+		return;
+	}
+	const auto session = &_history->session();
+	if (const auto item = session->data().message(id)) {
+		if (const auto text = Deserialize(value)) {
+			item->translationDone(to, Parse(session, *text));
+		} else if (_history->translatedTo() == to) {
+			_itemsToRequest.emplace(id, entry);
+		} else {
+			item->translationShowRequiresRequest({});
+		}
+	}
+	if (_itemsCheckingCache.empty()) {
+		// Send the misses in as few requests as possible.
+		requestSome();
 	}
 }
 
@@ -213,14 +293,21 @@ void TranslateTracker::addBunchFrom(
 }
 
 void TranslateTracker::cancelToRequest() {
+	const auto owner = &_history->owner();
 	if (!_itemsToRequest.empty()) {
-		const auto owner = &_history->owner();
 		for (const auto &[id, entry] : base::take(_itemsToRequest)) {
 			if (const auto item = owner->message(id)) {
 				item->translationShowRequiresRequest({});
 			}
 		}
 	}
+	if (!_itemsCheckingCache.empty()) {
+		for (const auto &id : base::take(_itemsCheckingCache)) {
+			if (const auto item = owner->message(id)) {
+				item->translationShowRequiresRequest({});
+			}
+		}
+	}
 }
 
 void TranslateTracker::cancelSentRequest() {
@@ -236,7 +323,9 @@ void TranslateTracker::cancelSentRequest() {
 }
 
 void TranslateTracker::requestSome() {
-	if (_requestId || _itemsToRequest.empty()) {
+	if (_requestId
+		|| _itemsToRequest.empty()
+		|| !_itemsCheckingCache.empty()) {
 		return;
 	}
 	const auto to = _history->translatedTo();
@@ -289,14 +378,19 @@ void TranslateTracker::requestDone(
 	const auto owner = &session->data();
 	for (const auto &id : base::take(_requested)) {
 		if (const auto item = owner->message(id)) {
-			const auto data = (index >= list.size())
+			const auto text = (index >= list.size())
 				? nullptr
-				: &list[index].data();
-			auto text = data ? TextWithEntities{
-				qs(data->vtext()),
-				Api::EntitiesFromMTP(session, data->ventities().v)
-			} : TextWithEntities();
-			item->translationDone(to, std::move(text));
+				: &list[index];
+			if (text) {
+				owner->cache().put(
+					CacheKey(item, to),
+					Storage::Cache::Database::TaggedValue(
+						Serialize(*text),
+						Data::kTextCacheTag));
+			}
+			item->translationDone(
+				to,
+				text ? Parse(session, *text) : TextWithEntities());
 		}
 		++index;
 	}
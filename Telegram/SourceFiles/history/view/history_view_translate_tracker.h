@@ -7,6 +7,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 */
 #pragma once
 
+#include "base/weak_ptr.h"
 #include "spellcheck/spellcheck_types.h"
 
 class History;
@@ -16,7 +17,7 @@ namespace HistoryView {
 
 class Element;
 
-class TranslateTracker final {
+class TranslateTracker final : public base::has_weak_ptr {
 public:
 	explicit TranslateTracker(not_null<History*> history);
 	~TranslateTracker();
@@ -53,6 +54,12 @@ private:
 	void cancelToRequest();
 	void cancelSentRequest();
 	void switchTranslation(not_null<HistoryItem*> item, LanguageId id);
+	void checkCached(not_null<HistoryItem*> item, LanguageId to);
+	void checkCachedDone(
+		FullMsgId id,
+		LanguageId to,
+		ItemToRequest entry,
+		QByteArray value);
 
 	void requestDone(
 		LanguageId to,
@@ -69,6 +76,7 @@ private:
 
 	base::flat_map<not_null<HistoryItem*>, LanguageId> _switchTranslations;
 	base::flat_map<FullMsgId, ItemToRequest> _itemsToRequest;
+	base::flat_set<FullMsgId> _itemsCheckingCache;
 	std::vector<FullMsgId> _requested;
 	mtpRequestId _requestId = 0;
 
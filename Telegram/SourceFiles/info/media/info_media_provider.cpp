@@ -202,6 +202,7 @@ std::optional<int> Provider::fullCount() {
 
 void Provider::restart() {
 	_layouts.clear();
+	_recycled.clear();
 	_universalAroundId = kDefaultAroundId;
 	_idsLimit = kMinimalIdsLimit;
 	_slice = SparseIdsMergedSlice(sliceKey(_universalAroundId));
@@ -315,14 +316,40 @@ void Provider::markLayoutsStale() {
 }
 
 void Provider::clearStaleLayouts() {
-	for (auto i = _layouts.begin(); i != _layouts.end();) {
-		if (i->second.stale) {
-			_layoutRemoved.fire(i->second.item.get());
-			i = _layouts.erase(i);
-		} else {
-			++i;
+	for (auto &[universalId, layout] : _layouts) {
+		if (layout.stale) {
+			recycleLayout(universalId, layout);
 		}
 	}
+	trimRecycledLayouts();
+}
+
+void Provider::recycleLayout(
+		UniversalMsgId universalId,
+		CachedItem &layout) {
+	if (ranges::contains(_recycled, universalId)) {
+		return;
+	}
+	// The layout left the sections, but we keep it (with its computed
+	// texts and dimensions) for a while, so that scrolling back and forth
+	// around the loaded slice boundary doesn't recreate it each time.
+	_layoutRemoved.fire(layout.item.get());
+	layout.item->clearHeavyPart();
+	_recycled.push_back(universalId);
+}
+
+void Provider::unrecycleLayout(UniversalMsgId universalId) {
+	const auto i = ranges::find(_recycled, universalId);
+	if (i != end(_recycled)) {
+		_recycled.erase(i);
+	}
+}
+
+void Provider::trimRecycledLayouts() {
+	while (_recycled.size() > kRecycledLayoutsLimit) {
+		_layouts.erase(_recycled.front());
+		_recycled.pop_front();
+	}
 }
 
 rpl::producer<not_null<BaseLayout*>> Provider::layoutRemoved() {
@@ -332,7 +359,9 @@ rpl::producer<not_null<BaseLayout*>> Provider::layoutRemoved() {
 BaseLayout *Provider::lookupLayout(
 		const HistoryItem *item) {
 	const auto i = _layouts.find(GetUniversalId(item));
-	return (i != _layouts.end()) ? i->second.item.get() : nullptr;
+	return (i != _layouts.end() && !i->second.stale)
+		? i->second.item.get()
+		: nullptr;
 }
 
 bool Provider::isMyItem(not_null<const HistoryItem*> item) {
@@ -366,7 +395,11 @@ SparseIdsMergedSlice::Key Provider::sliceKey(
 void Provider::itemRemoved(not_null<const HistoryItem*> item) {
 	const auto id = GetUniversalId(item);
 	if (const auto i = _layouts.find(id); i != end(_layouts)) {
-		_layoutRemoved.fire(i->second.item.get());
+		if (i->second.stale) {
+			unrecycleLayout(id);
+		} else {
+			_layoutRemoved.fire(i->second.item.get());
+		}
 		_layouts.erase(i);
 	}
 }
@@ -395,6 +428,8 @@ BaseLayout *Provider::getLayout(
 		} else {
 			return nullptr;
 		}
+	} else if (it->second.stale) {
+		unrecycleLayout(universalId);
 	}
 	it->second.stale = false;
 	return it->second.item.get();
@@ -516,7 +551,9 @@ void Provider::applyDragSelection(
 	}
 	for (auto &layoutItem : _layouts) {
 		auto &&universalId = layoutItem.first;
-		if (universalId <= fromId && universalId > tillId) {
+		if (layoutItem.second.stale) {
+			continue;
+		} else if (universalId <= fromId && universalId > tillId) {
 			const auto item = layoutItem.second.item->getItem();
 			ChangeItemSelection(
 				selected,
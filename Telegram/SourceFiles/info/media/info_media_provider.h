@@ -77,6 +77,7 @@ public:
 private:
 	static constexpr auto kMinimalIdsLimit = 16;
 	static constexpr auto kDefaultAroundId = (ServerMaxMsgId - 1);
+	static constexpr auto kRecycledLayoutsLimit = 256;
 
 	bool sectionHasFloatingHeader() override;
 	QString sectionTitle(not_null<const BaseLayout*> item) override;
@@ -100,6 +101,9 @@ private:
 	void itemRemoved(not_null<const HistoryItem*> item);
 	void markLayoutsStale();
 	void clearStaleLayouts();
+	void recycleLayout(UniversalMsgId universalId, CachedItem &layout);
+	void unrecycleLayout(UniversalMsgId universalId);
+	void trimRecycledLayouts();
 
 	const not_null<AbstractController*> _controller;
 
@@ -113,6 +117,7 @@ private:
 	SparseIdsMergedSlice _slice;
 
 	std::unordered_map<UniversalMsgId, CachedItem> _layouts;
+	std::deque<UniversalMsgId> _recycled;
 	rpl::event_stream<not_null<BaseLayout*>> _layoutRemoved;
 	rpl::event_stream<> _refreshed;
 
@@ -11,9 +11,11 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "api/api_updates.h"
 #include "api/api_send_progress.h"
 #include "api/api_user_privacy.h"
+#include "api/api_chat_list_snapshot.h"
 #include "main/main_account.h"
 #include "main/main_domain.h"
 #include "main/main_session_settings.h"
+#include "main/main_session_bootstrap.h"
 #include "main/main_app_config.h"
 #include "main/session/send_as_peers.h"
 #include "mtproto/mtproto_config.h"
@@ -82,6 +84,7 @@ Session::Session(
 	std::unique_ptr<SessionSettings> settings)
 : _account(account)
 , _settings(std::move(settings))
+, _bootstrap(std::make_unique<SessionBootstrap>(this))
 , _changes(std::make_unique<Data::Changes>(this))
 , _api(std::make_unique<ApiWrap>(this))
 , _updates(std::make_unique<Api::Updates>(this))
@@ -101,8 +104,21 @@ Session::Session(
 , _saveSettingsTimer([=] { saveSettings(); }) {
 	Expects(_settings != nullptr);
 
-	_api->requestTermsUpdate();
-	_api->requestFullPeer(_user);
+	_bootstrap->add({
+		.name = u"terms"_q,
+		.priority = BootstrapPriority::Visible,
+		.start = [=] { _api->requestTermsUpdate(); },
+	});
+	_bootstrap->add({
+		.name = u"self"_q,
+		.priority = BootstrapPriority::Background,
+		.start = [=] { _api->requestFullPeer(_user); },
+	});
+	_bootstrap->add({
+		.name = u"download_keys"_q,
+		.priority = BootstrapPriority::Background,
+		.start = [=] { _downloader->prewarm(mainDcId()); },
+	});
 
 	_api->instance().setUserPhone(_user->phone());
 
@@ -177,9 +193,15 @@ Session::Session(
 	Spellchecker::Start(this);
 #endif // TDESKTOP_DISABLE_SPELLCHECK
 
-	_api->requestNotifySettings(MTP_inputNotifyUsers());
-	_api->requestNotifySettings(MTP_inputNotifyChats());
-	_api->requestNotifySettings(MTP_inputNotifyBroadcasts());
+	_bootstrap->add({
+		.name = u"notify_settings"_q,
+		.priority = BootstrapPriority::Visible,
+		.start = [=] {
+			_api->requestNotifySettings(MTP_inputNotifyUsers());
+			_api->requestNotifySettings(MTP_inputNotifyChats());
+			_api->requestNotifySettings(MTP_inputNotifyBroadcasts());
+		},
+	});
 
 	Core::App().downloadManager().trackSession(this);
 }
@@ -207,6 +229,7 @@ void Session::finishLogout() {
 
 Session::~Session() {
 	unlockTerms();
+	_api->chatListSnapshot().write();
 	data().clear();
 	ClickHandler::clearActive();
 	ClickHandler::unpressed();
@@ -62,6 +62,7 @@ namespace Main {
 class Account;
 class Domain;
 class SessionSettings;
+class SessionBootstrap;
 class SendAsPeers;
 
 class Session final : public base::has_weak_ptr {
@@ -94,6 +95,9 @@ public:
 	}
 	bool validateSelf(UserId id);
 
+	[[nodiscard]] SessionBootstrap &bootstrap() const {
+		return *_bootstrap;
+	}
 	[[nodiscard]] Data::Changes &changes() const {
 		return *_changes;
 	}
@@ -193,6 +197,7 @@ private:
 	const not_null<Account*> _account;
 
 	const std::unique_ptr<SessionSettings> _settings;
+	const std::unique_ptr<SessionBootstrap> _bootstrap;
 	const std::unique_ptr<Data::Changes> _changes;
 	const std::unique_ptr<ApiWrap> _api;
 	const std::unique_ptr<Api::Updates> _updates;
@@ -0,0 +1,143 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "main/main_session_bootstrap.h"
+
+#include "main/main_session.h"
+
+namespace Main {
+namespace {
+
+constexpr auto kNextPhaseTimeout = crl::time(3000);
+constexpr auto kLogTimeout = crl::time(30000);
+
+[[nodiscard]] QString PriorityName(BootstrapPriority priority) {
+	switch (priority) {
+	case BootstrapPriority::Critical: return u"critical"_q;
+	case BootstrapPriority::Visible: return u"visible"_q;
+	case BootstrapPriority::Background: return u"background"_q;
+	}
+	Unexpected("Priority in PriorityName.");
+}
+
+} // namespace
+
+SessionBootstrap::SessionBootstrap(not_null<Session*> session)
+: _session(session)
+, _created(crl::now())
+, _phaseTimer([=] {
+	Expects(_phase.has_value());
+
+	if (*_phase != BootstrapPriority::Background) {
+		startPhase(BootstrapPriority(int(*_phase) + 1));
+	}
+})
+, _logTimer([=] { logWaterfall(); }) {
+}
+
+SessionBootstrap::~SessionBootstrap() = default;
+
+void SessionBootstrap::add(BootstrapStep &&step) {
+	Expects(step.start != nullptr);
+
+	_steps.push_back(std::make_unique<Step>(Step{ std::move(step) }));
+	const auto raw = _steps.back().get();
+	if (_phase && raw->data.priority <= *_phase) {
+		start(raw);
+	} else if (!_scheduled) {
+		_scheduled = true;
+
+		// Parts of the session can't be used until it is constructed.
+		crl::on_main(_session, [=] {
+			startPhase(BootstrapPriority::Critical);
+		});
+		_logTimer.callOnce(kLogTimeout);
+	}
+}
+
+void SessionBootstrap::usable() {
+	if (_usable) {
+		return;
+	}
+	_usable = crl::now();
+	if (!_phase || *_phase < BootstrapPriority::Visible) {
+		startPhase(BootstrapPriority::Visible);
+	}
+}
+
+void SessionBootstrap::startPhase(BootstrapPriority priority) {
+	if (_phase && *_phase >= priority) {
+		return;
+	}
+	_phase = priority;
+	for (const auto &step : _steps) {
+		if (!step->started && step->data.priority <= priority) {
+			start(step.get());
+		}
+	}
+	if (priority != BootstrapPriority::Background) {
+		_phaseTimer.callOnce(kNextPhaseTimeout);
+	}
+	checkPhaseFinished();
+}
+
+void SessionBootstrap::start(not_null<Step*> step) {
+	step->started = crl::now();
+	if (const auto finished = base::take(step->data.finished)) {
+		finished() | rpl::take(1) | rpl::start_with_next([=] {
+			finish(step);
+		}, step->lifetime);
+	} else {
+		step->finished = step->started;
+	}
+	step->data.start();
+}
+
+void SessionBootstrap::finish(not_null<Step*> step) {
+	step->finished = crl::now();
+	crl::on_main(_session, [=] {
+		checkPhaseFinished();
+	});
+}
+
+void SessionBootstrap::checkPhaseFinished() {
+	if (!_phase) {
+		return;
+	}
+	const auto finished = ranges::all_of(_steps, [&](const auto &step) {
+		return (step->data.priority > *_phase) || (step->finished != 0);
+	});
+	if (!finished) {
+		return;
+	} else if (*_phase == BootstrapPriority::Background) {
+		logWaterfall();
+	} else if (*_phase == BootstrapPriority::Visible) {
+		startPhase(BootstrapPriority::Background);
+	}
+}
+
+void SessionBootstrap::logWaterfall() {
+	if (_logged) {
+		return;
+	}
+	_logged = true;
+	_logTimer.cancel();
+	DEBUG_LOG(("Bootstrap: Usable in %1 ms."
+		).arg(_usable ? QString::number(_usable - _created) : u"-"_q));
+	for (const auto &step : _steps) {
+		const auto offset = [&](crl::time when) {
+			return when ? QString::number(when - _created) : u"-"_q;
+		};
+		DEBUG_LOG(("Bootstrap: %1 (%2) started at %3 ms, finished at %4 ms."
+			).arg(step->data.name
+			).arg(PriorityName(step->data.priority)
+			).arg(offset(step->started)
+			).arg(offset(step->finished)));
+	}
+}
+
+} // namespace Main
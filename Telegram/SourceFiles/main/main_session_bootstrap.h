@@ -0,0 +1,79 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+#include "base/timer.h"
+
+namespace Main {
+
+class Session;
+
+enum class BootstrapPriority : uchar {
+	Critical, // Right after the session is started.
+	Visible, // When the first page of the chats list is received.
+	Background, // When everything visible is finished.
+};
+
+struct BootstrapStep {
+	QString name;
+	BootstrapPriority priority = BootstrapPriority::Background;
+	Fn<void()> start;
+
+	// If not set the step is finished right after it is started.
+	Fn<rpl::producer<>()> finished;
+};
+
+// Startup requests of different parts of the session are not sent each on
+// its own timer, but phase by phase, all requests of one phase in the same
+// event loop iteration, so that they're packed in a few containers.
+//
+// Some startup work is intentionally not a step here:
+// - AppConfig belongs to Main::Account, it is requested when the main
+//   MTP instance starts, before any session, and is used at login.
+// - Installed / recent / faved stickers are only read from the local
+//   storage, their server refresh is lazy (when the panel is opened or
+//   an update arrives) and reading them later would race such a refresh.
+// - GlobalPrivacy is reloaded only when the server suggests to archive
+//   and mute new chats, that comes with AppConfig and isn't a request.
+class SessionBootstrap final {
+public:
+	explicit SessionBootstrap(not_null<Session*> session);
+	~SessionBootstrap();
+
+	void add(BootstrapStep &&step);
+
+	// The first page of the chats list was received.
+	void usable();
+
+private:
+	struct Step {
+		BootstrapStep data;
+		crl::time started = 0;
+		crl::time finished = 0;
+		rpl::lifetime lifetime;
+	};
+
+	void startPhase(BootstrapPriority priority);
+	void start(not_null<Step*> step);
+	void finish(not_null<Step*> step);
+	void checkPhaseFinished();
+	void logWaterfall();
+
+	const not_null<Session*> _session;
+	const crl::time _created = 0;
+	std::vector<std::unique_ptr<Step>> _steps;
+	std::optional<BootstrapPriority> _phase;
+	base::Timer _phaseTimer;
+	base::Timer _logTimer;
+	crl::time _usable = 0;
+	bool _scheduled = false;
+	bool _logged = false;
+
+};
+
+} // namespace Main
@@ -25,6 +25,11 @@ constexpr auto kCaptureSkipDuration = crl::time(400);
 constexpr auto kCaptureFadeInDuration = crl::time(300);
 constexpr auto kCaptureBufferSlice = 256 * 1024;
 constexpr auto kCaptureUpdateDelta = crl::time(100);
+constexpr auto kEncodedBufferSlice = 64 * 1024;
+
+// Waveform peaks are accumulated with a fixed memory budget, two adjacent
+// peaks are merged into one when the budget is reached.
+constexpr auto kMaxWaveformPeaks = 4096;
 
 Instance *CaptureInstance = nullptr;
 
@@ -44,11 +49,17 @@ public:
 	Inner(QThread *thread);
 	~Inner();
 
-	void start(Fn<void(Update)> updated, Fn<void()> error);
+	void start(
+		Fn<void(Update)> updated,
+		Fn<void(Chunk)> encoded,
+		Fn<void()> error);
 	void stop(Fn<void(Result&&)> callback = nullptr);
 
 private:
 	void process();
+	void publishEncoded();
+	void compactCaptured();
+	void pushWaveformPeak(uint16 peak);
 
 	[[nodiscard]] bool processFrame(int32 offset, int32 framesize);
 	void fail();
@@ -60,12 +71,17 @@ private:
 	[[nodiscard]] int writePackets();
 
 	Fn<void(Update)> _updated;
+	Fn<void(Chunk)> _encoded;
 	Fn<void()> _error;
 
 	struct Private;
 	const std::unique_ptr<Private> d;
 	base::Timer _timer;
+
+	// Samples before _capturedOffset are already encoded. The buffer is
+	// compacted only once that prefix grows over kCaptureBufferSlice.
 	QByteArray _captured;
+	int _capturedOffset = 0;
 
 };
 
@@ -91,6 +107,10 @@ void Instance::start() {
 			crl::on_main(this, [=] {
 				_updates.fire_copy(update);
 			});
+		}, [=](Chunk chunk) {
+			crl::on_main(this, [=, chunk = std::move(chunk)]() mutable {
+				_encoded.fire(std::move(chunk));
+			});
 		}, [=] {
 			crl::on_main(this, [=] {
 				_updates.fire_error({});
@@ -172,6 +192,11 @@ struct Instance::Inner::Private {
 	QByteArray data;
 	int32 dataPos = 0;
 
+	// Bytes before dataPublished were already sent by chunks. If the muxer
+	// seeks back into that part the chunks are not valid anymore.
+	int32 dataPublished = 0;
+	bool dataRewritten = false;
+
 	int64 waveformMod = 0;
 	int64 waveformEach = (kCaptureFrequency / 100);
 	uint16 waveformPeak = 0;
@@ -194,7 +219,20 @@ struct Instance::Inner::Private {
 		auto l = reinterpret_cast<Private*>(opaque);
 
 		if (buf_size <= 0) return 0;
-		if (l->dataPos + buf_size > l->data.size()) l->data.resize(l->dataPos + buf_size);
+		if (l->dataPos < l->dataPublished) l->dataRewritten = true;
+		if (l->dataPos + buf_size > l->data.size()) {
+			const auto size = l->dataPos + buf_size;
+			if (size > l->data.capacity()) {
+				// Grow geometrically, so that a long recording is not
+				// copied over and over again on each reallocation.
+				l->data.reserve(std::max({
+					size,
+					2 * int(l->data.capacity()),
+					kEncodedBufferSlice,
+				}));
+			}
+			l->data.resize(size);
+		}
 		memcpy(l->data.data() + l->dataPos, buf, buf_size);
 		l->dataPos += buf_size;
 		return buf_size;
@@ -238,8 +276,12 @@ void Instance::Inner::fail() {
 	}
 }
 
-void Instance::Inner::start(Fn<void(Update)> updated, Fn<void()> error) {
+void Instance::Inner::start(
+		Fn<void(Update)> updated,
+		Fn<void(Chunk)> encoded,
+		Fn<void()> error) {
 	_updated = std::move(updated);
+	_encoded = std::move(encoded);
 	_error = std::move(error);
 
 	// Start OpenAL Capture
@@ -400,7 +442,10 @@ void Instance::Inner::start(Fn<void(Update)> updated, Fn<void()> error) {
 
 	_timer.callEach(50);
 	_captured.clear();
-	_captured.reserve(kCaptureBufferSlice);
+	_captured.reserve(2 * kCaptureBufferSlice);
+	_capturedOffset = 0;
+	d->waveform.reserve(kMaxWaveformPeaks);
+	publishEncoded();
 	DEBUG_LOG(("Audio Capture: started!"));
 }
 
@@ -422,6 +467,7 @@ void Instance::Inner::stop(Fn<void(Result&&)> callback) {
 		alcCaptureCloseDevice(d->device);
 		d->device = nullptr;
 	}
+	compactCaptured();
 
 	// Write what is left
 	if (needResult && !_captured.isEmpty()) {
@@ -470,6 +516,7 @@ void Instance::Inner::stop(Fn<void(Result&&)> callback) {
 		).arg(d->data.size()
 		).arg(d->fullSamples));
 	_captured = QByteArray();
+	_capturedOffset = 0;
 
 	// Finish stream
 	if (needResult && hadDevice) {
@@ -477,6 +524,9 @@ void Instance::Inner::stop(Fn<void(Result&&)> callback) {
 	}
 
 	QByteArray result = d->fullSamples ? d->data : QByteArray();
+	const auto streamed = !result.isEmpty()
+		&& !d->dataRewritten
+		&& (d->dataPublished > 0);
 	VoiceWaveform waveform;
 	qint32 samples = d->fullSamples;
 	if (needResult && samples && !d->waveform.isEmpty()) {
@@ -554,14 +604,18 @@ void Instance::Inner::stop(Fn<void(Result&&)> callback) {
 
 		d->dataPos = 0;
 		d->data.clear();
+		d->dataPublished = 0;
+		d->dataRewritten = false;
 
 		d->waveformMod = 0;
+		d->waveformEach = (kCaptureFrequency / 100);
 		d->waveformPeak = 0;
 		d->waveform.clear();
 	}
+	_encoded = nullptr;
 
 	if (needResult) {
-		callback({ result, waveform, samples });
+		callback({ result, waveform, samples, streamed });
 	}
 }
 
@@ -598,7 +652,8 @@ void Instance::Inner::process() {
 		// Count new recording level and update view
 		auto skipSamples = kCaptureSkipDuration * kCaptureFrequency / 1000;
 		auto fadeSamples = kCaptureFadeInDuration * kCaptureFrequency / 1000;
-		auto levelindex = d->fullSamples + static_cast<int>(s / sizeof(short));
+		auto levelindex = d->fullSamples
+			+ static_cast<int>((s - _capturedOffset) / sizeof(short));
 		for (auto ptr = (const short*)(_captured.constData() + s), end = (const short*)(_captured.constData() + news); ptr < end; ++ptr, ++levelindex) {
 			if (levelindex > skipSamples) {
 				uint16 value = qAbs(*ptr);
@@ -610,32 +665,68 @@ void Instance::Inner::process() {
 				}
 			}
 		}
-		qint32 samplesFull = d->fullSamples + _captured.size() / sizeof(short), samplesSinceUpdate = samplesFull - d->lastUpdate;
+		qint32 samplesFull = d->fullSamples + (_captured.size() - _capturedOffset) / sizeof(short), samplesSinceUpdate = samplesFull - d->lastUpdate;
 		if (samplesSinceUpdate > kCaptureUpdateDelta * kCaptureFrequency / 1000) {
 			_updated(Update{ .samples = samplesFull, .level = d->levelMax });
 			d->lastUpdate = samplesFull;
 			d->levelMax = 0;
 		}
 		// Write frames
-		int32 framesize = d->srcSamples * d->channels * sizeof(short), encoded = 0;
-		while (uint32(_captured.size()) >= encoded + framesize + fadeSamples * sizeof(short)) {
-			if (!processFrame(encoded, framesize)) {
+		int32 framesize = d->srcSamples * d->channels * sizeof(short);
+		while (uint32(_captured.size()) >= _capturedOffset + framesize + fadeSamples * sizeof(short)) {
+			if (!processFrame(_capturedOffset, framesize)) {
 				return;
 			}
-			encoded += framesize;
+			_capturedOffset += framesize;
 		}
-
-		// Collapse the buffer
-		if (encoded > 0) {
-			int32 goodSize = _captured.size() - encoded;
-			memmove(_captured.data(), _captured.constData() + encoded, goodSize);
-			_captured.resize(goodSize);
+		if (_capturedOffset >= kCaptureBufferSlice) {
+			compactCaptured();
 		}
+		publishEncoded();
 	} else {
 		DEBUG_LOG(("Audio Capture: no samples to capture."));
 	}
 }
 
+void Instance::Inner::compactCaptured() {
+	if (!_capturedOffset) {
+		return;
+	}
+	const auto left = _captured.size() - _capturedOffset;
+	memmove(_captured.data(), _captured.constData() + _capturedOffset, left);
+	_captured.resize(left);
+	_capturedOffset = 0;
+}
+
+void Instance::Inner::publishEncoded() {
+	if (!_encoded || d->dataRewritten) {
+		return;
+	}
+	const auto size = d->data.size();
+	if (size <= d->dataPublished) {
+		return;
+	}
+	const auto offset = base::take(d->dataPublished);
+	d->dataPublished = size;
+	_encoded({
+		.bytes = d->data.mid(offset),
+		.offset = offset,
+	});
+}
+
+void Instance::Inner::pushWaveformPeak(uint16 peak) {
+	if (d->waveform.size() == kMaxWaveformPeaks) {
+		for (auto i = 0; i != kMaxWaveformPeaks / 2; ++i) {
+			d->waveform[i] = std::max(
+				d->waveform[2 * i],
+				d->waveform[2 * i + 1]);
+		}
+		d->waveform.resize(kMaxWaveformPeaks / 2);
+		d->waveformEach *= 2;
+	}
+	d->waveform.push_back(uchar(peak / 256));
+}
+
 bool Instance::Inner::processFrame(int32 offset, int32 framesize) {
 	// Prepare audio frame
 
@@ -667,16 +758,14 @@ bool Instance::Inner::processFrame(int32 offset, int32 framesize) {
 		}
 	}
 
-	d->waveform.reserve(d->waveform.size() + (samplesCnt / d->waveformEach) + 1);
 	for (short *ptr = srcSamplesDataChannel, *end = ptr + samplesCnt; ptr != end; ++ptr) {
 		uint16 value = qAbs(*ptr);
 		if (d->waveformPeak < value) {
 			d->waveformPeak = value;
 		}
-		if (++d->waveformMod == d->waveformEach) {
-			d->waveformMod -= d->waveformEach;
-			d->waveform.push_back(uchar(d->waveformPeak / 256));
-			d->waveformPeak = 0;
+		if (++d->waveformMod >= d->waveformEach) {
+			d->waveformMod = 0;
+			pushWaveformPeak(base::take(d->waveformPeak));
 		}
 	}
 
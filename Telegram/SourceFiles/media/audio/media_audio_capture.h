@@ -19,10 +19,19 @@ struct Update {
 	ushort level = 0;
 };
 
+// Part of the encoded file, available while the recording continues.
+struct Chunk {
+	QByteArray bytes;
+	int offset = 0;
+};
+
 struct Result {
 	QByteArray bytes;
 	VoiceWaveform waveform;
 	int samples = 0;
+
+	// All the chunks from encoded() were the prefix of the bytes.
+	bool streamed = false;
 };
 
 void Start();
@@ -41,6 +50,9 @@ public:
 	[[nodiscard]] rpl::producer<Update, rpl::empty_error> updated() const {
 		return _updates.events();
 	}
+	[[nodiscard]] rpl::producer<Chunk> encoded() const {
+		return _encoded.events();
+	}
 
 	[[nodiscard]] bool started() const {
 		return _started.current();
@@ -59,6 +71,7 @@ private:
 	bool _available = false;
 	rpl::variable<bool> _started = false;;
 	rpl::event_stream<Update, rpl::empty_error> _updates;
+	rpl::event_stream<Chunk> _encoded;
 	QThread _thread;
 	std::unique_ptr<Inner> _inner;
 
@@ -10,6 +10,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "media/streaming/media_streaming_common.h"
 #include "media/streaming/media_streaming_loader.h"
 #include "storage/cache/storage_cache_database.h"
+#include "storage/storage_cache_stats.h"
 
 namespace Media {
 namespace Streaming {
@@ -856,9 +857,11 @@ Reader::SerializedSlice Reader::Slices::unloadToCache() {
 
 Reader::Reader(
 	std::unique_ptr<Loader> loader,
-	Storage::Cache::Database *cache)
+	Storage::Cache::Database *cache,
+	std::shared_ptr<Storage::CacheStats> cacheStats)
 : _loader(std::move(loader))
 , _cache(cache)
+, _cacheStats(std::move(cacheStats))
 , _cacheHelper(cache ? InitCacheHelper(_loader->baseCacheKey()) : nullptr)
 , _slices(_loader->size(), _cacheHelper != nullptr) {
 	_loader->parts(
@@ -1148,9 +1151,13 @@ void Reader::readFromCache(int sliceNumber) {
 	const auto key = _cacheHelper->key(sliceNumber);
 	const auto cache = std::weak_ptr<CacheHelper>(_cacheHelper);
 	const auto weak = base::make_weak(this);
+	const auto stats = _cacheStats;
 	const auto ready = [=](
 			QByteArray &&result,
 			std::vector<int> &&sizes = {}) {
+		if (stats) {
+			stats->read(Storage::CacheStatsTag::VideoParts, result.size());
+		}
 		crl::async([
 			=,
 			result = std::move(result),
@@ -1202,6 +1209,11 @@ void Reader::putToCache(SerializedSlice &&slice) {
 	Expects(_cacheHelper != nullptr);
 	Expects(slice.number >= 0);
 
+	if (_cacheStats) {
+		_cacheStats->written(
+			Storage::CacheStatsTag::VideoParts,
+			slice.data.size());
+	}
 	_cache->put(_cacheHelper->key(slice.number), std::move(slice.data));
 }
 
@@ -14,6 +14,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 
 namespace Storage {
 class StreamedFileDownloader;
+class CacheStats;
 } // namespace Storage
 
 namespace Storage {
@@ -42,7 +43,8 @@ public:
 	// Main thread.
 	explicit Reader(
 		std::unique_ptr<Loader> loader,
-		Storage::Cache::Database *cache = nullptr);
+		Storage::Cache::Database *cache = nullptr,
+		std::shared_ptr<Storage::CacheStats> cacheStats = nullptr);
 
 	void setLoaderPriority(int priority);
 
@@ -239,6 +241,7 @@ private:
 
 	const std::unique_ptr<Loader> _loader;
 	Storage::Cache::Database * const _cache = nullptr;
+	const std::shared_ptr<Storage::CacheStats> _cacheStats;
 
 	// shared_ptr is used to be able to have weak_ptr.
 	const std::shared_ptr<CacheHelper> _cacheHelper;
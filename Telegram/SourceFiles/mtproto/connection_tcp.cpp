@@ -21,6 +21,7 @@ constexpr auto kPacketSizeMax = int(0x01000000 * sizeof(mtpPrime));
 constexpr auto kFullConnectionTimeout = 8 * crl::time(1000);
 constexpr auto kSmallBufferSize = 256 * 1024;
 constexpr auto kMinPacketBuffer = 256;
+constexpr auto kKeepLargeBufferSize = 2 * 1024 * 1024;
 constexpr auto kConnectionStartPrefixSize = 64;
 
 } // namespace
@@ -269,22 +270,48 @@ void TcpConnection::ensureAvailableInBuffer(int amount) {
 		if (_usingLargeBuffer) {
 			bytes::copy(_smallBuffer, read);
 			_usingLargeBuffer = false;
-			_largeBuffer.clear();
+			releaseLargeBuffer();
 		} else {
 			bytes::move(_smallBuffer, read);
 		}
-	} else if (amount <= _largeBuffer.size()) {
-		Assert(_usingLargeBuffer);
+	} else if (_usingLargeBuffer) {
 		bytes::move(_largeBuffer, read);
+		if (_largeBuffer.size() < amount) {
+			_largeBuffer.resize(amount);
+			++_largeBufferAllocations;
+		}
 	} else {
-		auto enough = bytes::vector(amount);
-		bytes::copy(enough, read);
-		_largeBuffer = std::move(enough);
+		// The large buffer is kept between packets, so that a sequence
+		// of file parts is received without allocations for each of them.
+		if (_largeBuffer.size() < amount) {
+			_largeBuffer = bytes::vector(amount);
+			++_largeBufferAllocations;
+		}
+		bytes::copy(_largeBuffer, read);
 		_usingLargeBuffer = true;
 	}
 	_offsetBytes = 0;
 }
 
+void TcpConnection::releaseLargeBuffer() {
+	if (_largeBuffer.size() > kKeepLargeBufferSize) {
+		_largeBuffer = bytes::vector();
+	}
+}
+
+void TcpConnection::logReadStats() {
+	if (!_readCalls) {
+		return;
+	}
+	const auto megabytes = std::max(_receivedBytes / float64(1024 * 1024), 1.);
+	CONNECTION_LOG_INFO(u"Received %1 bytes in %2 reads (%3 per MB), "
+		"%4 large buffer allocations."_q
+		.arg(_receivedBytes)
+		.arg(_readCalls)
+		.arg(int(base::SafeRound(_readCalls / megabytes)))
+		.arg(_largeBufferAllocations));
+}
+
 void TcpConnection::socketRead() {
 	Expects(_leftBytes > 0 || !_usingLargeBuffer);
 
@@ -307,7 +334,9 @@ void TcpConnection::socketRead() {
 		const auto full = bytes::make_span(buffer).subspan(_offsetBytes);
 		const auto free = full.subspan(_readBytes);
 		const auto readCount = _socket->read(free.subspan(0, readLimit));
+		++_readCalls;
 		if (readCount > 0) {
+			_receivedBytes += readCount;
 			const auto read = free.subspan(0, readCount);
 			aesCtrEncrypt(read, _receiveKey, &_receiveState);
 			CONNECTION_LOG_INFO(u"Read %1 bytes"_q.arg(readCount));
@@ -322,8 +351,9 @@ void TcpConnection::socketRead() {
 						return;
 					}
 
-					_usingLargeBuffer = false;
-					_largeBuffer.clear();
+					if (base::take(_usingLargeBuffer)) {
+						releaseLargeBuffer();
+					}
 					_offsetBytes = _readBytes = 0;
 				} else {
 					CONNECTION_LOG_INFO(
@@ -501,6 +531,7 @@ void TcpConnection::disconnectFromServer() {
 	_connectedLifetime.destroy();
 	_lifetime.destroy();
 	_socket = nullptr;
+	logReadStats();
 }
 
 void TcpConnection::connectToServer(
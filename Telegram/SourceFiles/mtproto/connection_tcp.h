@@ -62,6 +62,8 @@ private:
 
 	mtpBuffer parsePacket(bytes::const_span bytes);
 	void ensureAvailableInBuffer(int amount);
+	void releaseLargeBuffer();
+	void logReadStats();
 	static uint32 fourCharsToUInt(char ch1, char ch2, char ch3, char ch4) {
 		char ch[4] = { ch1, ch2, ch3, ch4 };
 		return *reinterpret_cast<uint32*>(ch);
@@ -77,6 +79,9 @@ private:
 	bytes::vector _smallBuffer;
 	bytes::vector _largeBuffer;
 	bool _usingLargeBuffer = false;
+	int64 _receivedBytes = 0;
+	int _readCalls = 0;
+	int _largeBufferAllocations = 0;
 
 	uchar _sendKey[CTRState::KeySize];
 	CTRState _sendState;
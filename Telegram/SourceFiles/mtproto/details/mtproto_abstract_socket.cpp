@@ -10,7 +10,38 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "mtproto/details/mtproto_tcp_socket.h"
 #include "mtproto/details/mtproto_tls_socket.h"
 
+#ifdef Q_OS_LINUX
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#endif // Q_OS_LINUX
+
 namespace MTP::details {
+namespace {
+
+[[nodiscard]] QString KernelStats(const QTcpSocket &socket) {
+#ifdef Q_OS_LINUX
+	const auto descriptor = socket.socketDescriptor();
+	if (descriptor < 0) {
+		return QString();
+	}
+	auto info = tcp_info();
+	auto length = socklen_t(sizeof(info));
+	if (getsockopt(int(descriptor), IPPROTO_TCP, TCP_INFO, &info, &length)) {
+		return QString();
+	}
+	return u", rtt %1/%2 us, retransmits %3, cwnd %4, mss %5"_q
+		.arg(info.tcpi_rtt)
+		.arg(info.tcpi_rttvar)
+		.arg(info.tcpi_total_retrans)
+		.arg(info.tcpi_snd_cwnd)
+		.arg(info.tcpi_snd_mss);
+#else // Q_OS_LINUX
+	return QString();
+#endif // Q_OS_LINUX
+}
+
+} // namespace
 
 std::unique_ptr<AbstractSocket> AbstractSocket::Create(
 		not_null<QThread*> thread,
@@ -28,6 +59,79 @@ std::unique_ptr<AbstractSocket> AbstractSocket::Create(
 	}
 }
 
+void AbstractSocket::prepareSocket(
+		QTcpSocket &socket,
+		const QNetworkProxy &proxy,
+		bool protocolForFiles) {
+	_protocolForFiles = protocolForFiles;
+	socket.moveToThread(thread());
+	socket.setProxy(proxy);
+	if (protocolForFiles) {
+		socket.setSocketOption(
+			QAbstractSocket::SendBufferSizeSocketOption,
+			kFilesSendBufferSize);
+		socket.setSocketOption(
+			QAbstractSocket::ReceiveBufferSizeSocketOption,
+			kFilesReceiveBufferSize);
+	}
+}
+
+void AbstractSocket::socketConnected(QTcpSocket &socket) {
+	_stats.connected = crl::now();
+
+	// Packets are written whole, so waiting for more data never helps.
+	socket.setSocketOption(QAbstractSocket::LowDelayOption, 1);
+
+	// File connections are dropped when idle, main ones are kept alive.
+	socket.setSocketOption(
+		QAbstractSocket::KeepAliveOption,
+		_protocolForFiles ? 0 : 1);
+}
+
+void AbstractSocket::countRead(int64 size) {
+	if (size <= 0) {
+		return;
+	}
+	_stats.bytesRead += size;
+	++_stats.reads;
+	if (const auto since = base::take(_stats.waitingSince)) {
+		auto bucket = 0;
+		for (auto ms = crl::now() - since; ms > 1; ms >>= 1) {
+			++bucket;
+		}
+		++_stats.latency[std::min(bucket, kLatencyBuckets - 1)];
+	}
+}
+
+void AbstractSocket::countWritten(int64 size) {
+	_stats.bytesWritten += size;
+	++_stats.writes;
+	if (!_stats.waitingSince) {
+		_stats.waitingSince = crl::now();
+	}
+}
+
+void AbstractSocket::logStats(const QTcpSocket &socket) const {
+	if (!_stats.connected) {
+		return;
+	}
+	auto latency = QStringList();
+	for (const auto count : _stats.latency) {
+		latency.push_back(QString::number(count));
+	}
+	DEBUG_LOG(("Socket %1 Info: "
+		"%2 s connected, read %3 bytes in %4, wrote %5 bytes in %6, "
+		"latency [%7]%8."
+		).arg(_debugId
+		).arg((crl::now() - _stats.connected) / 1000
+		).arg(_stats.bytesRead
+		).arg(_stats.reads
+		).arg(_stats.bytesWritten
+		).arg(_stats.writes
+		).arg(latency.join(',')
+		).arg(KernelStats(socket)));
+}
+
 void AbstractSocket::logError(int errorCode, const QString &errorText) {
 	const auto log = [&](const QString &message) {
 		DEBUG_LOG(("Socket %1 Error: ").arg(_debugId) + message);
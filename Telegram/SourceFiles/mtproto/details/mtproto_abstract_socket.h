@@ -64,6 +64,15 @@ protected:
 
 	void logError(int errorCode, const QString &errorText);
 
+	void prepareSocket(
+		QTcpSocket &socket,
+		const QNetworkProxy &proxy,
+		bool protocolForFiles);
+	void socketConnected(QTcpSocket &socket);
+	void countRead(int64 size);
+	void countWritten(int64 size);
+	void logStats(const QTcpSocket &socket) const;
+
 	QString _debugId;
 	rpl::event_stream<> _connected;
 	rpl::event_stream<> _disconnected;
@@ -71,6 +80,24 @@ protected:
 	rpl::event_stream<> _error;
 	rpl::event_stream<> _syncTimeRequests;
 
+private:
+	static constexpr auto kLatencyBuckets = 12;
+
+	struct Stats {
+		int64 bytesRead = 0;
+		int64 bytesWritten = 0;
+		int reads = 0;
+		int writes = 0;
+		crl::time connected = 0;
+		crl::time waitingSince = 0;
+
+		// Time from a write till the next read, by powers of two in ms.
+		std::array<int, kLatencyBuckets> latency = { { 0 } };
+	};
+
+	Stats _stats;
+	bool _protocolForFiles = false;
+
 };
 
 } // namespace MTP::details
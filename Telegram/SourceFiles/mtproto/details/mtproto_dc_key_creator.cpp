@@ -387,7 +387,8 @@ DcKeyCreator::DcKeyCreator(
 , _dcId(dcId)
 , _protocolDcId(protocolDcId)
 , _request(request)
-, _delegate(std::move(delegate)) {
+, _delegate(std::move(delegate))
+, _started(crl::now()) {
 	Expects(_request.temporaryExpiresIn > 0);
 	Expects(_delegate.done != nullptr);
 
@@ -535,13 +536,15 @@ void DcKeyCreator::pqAnswered(
 
 		DEBUG_LOG(("AuthKey Info: parsing pq..."));
 		const auto &pq = data.vpq().v;
+		const auto parseStarted = crl::now();
 		const auto parsed = FactorizePQ(data.vpq().v);
 		if (parsed.p.isEmpty() || parsed.q.isEmpty()) {
 			LOG(("AuthKey Error: could not factor pq!"));
 			DEBUG_LOG(("AuthKey Error: problematic pq: %1").arg(Logs::mb(pq.constData(), pq.length()).str()));
 			return failed();
 		}
-		DEBUG_LOG(("AuthKey Info: parse pq done."));
+		DEBUG_LOG(("AuthKey Info: parse pq done in %1 ms."
+			).arg(crl::now() - parseStarted));
 
 		const auto dhEncString = [&] {
 			return (attempt->expiresIn == 0)
@@ -702,6 +705,7 @@ void DcKeyCreator::dhClientParamsSend(not_null<Attempt*> attempt) {
 	}
 
 	// gen rand 'b'
+	const auto computeStarted = crl::now();
 	auto randomSeed = bytes::vector(ModExpFirst::kRandomPowerSize);
 	bytes::set_random(randomSeed);
 	auto g_b_data = CreateModExp(attempt->data.g, attempt->dhPrime, randomSeed);
@@ -716,6 +720,8 @@ void DcKeyCreator::dhClientParamsSend(not_null<Attempt*> attempt) {
 		return failed();
 	}
 	AuthKey::FillData(attempt->authKey, computedAuthKey);
+	DEBUG_LOG(("AuthKey Info: g_b and auth_key computed in %1 ms."
+		).arg(crl::now() - computeStarted));
 
 	auto auth_key_sha = openssl::Sha1(attempt->authKey);
 	memcpy(&attempt->data.auth_key_aux_hash.v, auth_key_sha.data(), 8);
@@ -839,6 +845,11 @@ void DcKeyCreator::done() {
 		result.persistentServerSalt = _persistent.data.doneSalt;
 	}
 
+	DEBUG_LOG(("AuthKey Info: %1 for dc %2 created in %3 ms."
+		).arg(result.persistentKey ? "keys" : "temporary key"
+		).arg(_dcId
+		).arg(crl::now() - _started));
+
 	stopReceiving();
 	auto onstack = base::take(_delegate.done);
 	onstack(std::move(result));
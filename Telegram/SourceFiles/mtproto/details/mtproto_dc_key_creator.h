@@ -130,6 +130,7 @@ private:
 	const int16 _protocolDcId = 0;
 	const DcKeyRequest _request;
 	Delegate _delegate;
+	const crl::time _started = 0;
 
 	Attempt _temporary;
 	Attempt _persistent;
@@ -9,9 +9,102 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 
 #include "base/random.h"
 
+#include <mutex>
+
 namespace MTP::details {
 namespace {
 
+// Buffers of sent requests are reused by size classes of powers of two,
+// from 64 bytes to 16 KB, so that bursts of small requests don't allocate.
+constexpr auto kMinPoolClass = 4;
+constexpr auto kMaxPoolClass = 12;
+constexpr auto kMaxPooledPerClass = 64;
+constexpr auto kLogStatsEach = 1024 * 1024;
+
+class BufferPool final {
+public:
+	[[nodiscard]] mtpBuffer take(uint32 size);
+	void release(mtpBuffer &&buffer);
+
+private:
+	std::mutex _mutex;
+	std::array<
+		std::vector<mtpBuffer>,
+		kMaxPoolClass - kMinPoolClass + 1> _classes;
+	int64 _taken = 0;
+	int64 _reused = 0;
+
+};
+
+[[nodiscard]] int SizeClassFor(uint32 size) {
+	auto result = kMinPoolClass;
+	while (result <= kMaxPoolClass && (uint32(1) << result) < size) {
+		++result;
+	}
+	return result;
+}
+
+[[nodiscard]] int SizeClassOf(int capacity) {
+	if (capacity < (1 << kMinPoolClass)
+		|| capacity > (1 << kMaxPoolClass)) {
+		return kMinPoolClass - 1;
+	}
+	auto result = kMinPoolClass;
+	while (result < kMaxPoolClass && (1 << (result + 1)) <= capacity) {
+		++result;
+	}
+	return result;
+}
+
+[[nodiscard]] BufferPool &Pool() {
+	// Never destroyed, requests may still be released on exit.
+	static const auto result = new BufferPool();
+	return *result;
+}
+
+mtpBuffer BufferPool::take(uint32 size) {
+	const auto sizeClass = SizeClassFor(size);
+	auto result = mtpBuffer();
+	auto reused = false;
+	{
+		auto lock = std::unique_lock(_mutex);
+		if (sizeClass <= kMaxPoolClass) {
+			auto &list = _classes[sizeClass - kMinPoolClass];
+			if (!list.empty()) {
+				result = std::move(list.back());
+				list.pop_back();
+				reused = true;
+				++_reused;
+			}
+		}
+		if (!(++_taken % kLogStatsEach)) {
+			DEBUG_LOG(("MTP Buffers: %1 of %2 requests reused buffers."
+				).arg(_reused
+				).arg(_taken));
+		}
+	}
+	if (!reused) {
+		result.reserve((sizeClass <= kMaxPoolClass)
+			? (1 << sizeClass)
+			: size);
+	}
+	return result;
+}
+
+void BufferPool::release(mtpBuffer &&buffer) {
+	// Large buffers, like uploaded file parts, are not kept at all.
+	const auto sizeClass = SizeClassOf(buffer.capacity());
+	if (sizeClass < kMinPoolClass || !buffer.isDetached()) {
+		return;
+	}
+	buffer.clear();
+	auto lock = std::unique_lock(_mutex);
+	auto &list = _classes[sizeClass - kMinPoolClass];
+	if (list.size() < kMaxPooledPerClass) {
+		list.push_back(std::move(buffer));
+	}
+}
+
 uint32 CountPaddingPrimesCount(
 		uint32 requestSize,
 		bool forAuthKeyInner) {
@@ -47,13 +140,18 @@ SerializedRequest SerializedRequest::Prepare(
 	const auto finalSize = std::max(size, reserveSize);
 
 	auto result = SerializedRequest(RequestConstructHider::Tag{});
-	result->reserve(kMessageBodyPosition + finalSize);
+	static_cast<mtpBuffer&>(*result) = Pool().take(
+		kMessageBodyPosition + finalSize);
 	result->resize(kMessageBodyPosition);
 	result->back() = (size << 2);
 	result->lastSentTime = crl::now();
 	return result;
 }
 
+RequestData::~RequestData() {
+	Pool().release(std::move(static_cast<mtpBuffer&>(*this)));
+}
+
 RequestData *SerializedRequest::operator->() const {
 	Expects(_data != nullptr);
 
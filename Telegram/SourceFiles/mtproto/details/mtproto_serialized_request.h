@@ -39,6 +39,7 @@ public:
 	static constexpr auto kMessageLengthInts = 1;
 	static constexpr auto kMessageBodyPosition = kMessageLengthPosition
 		+ kMessageLengthInts;
+	static constexpr auto kMaxPaddingInts = 6 + (0x0F << 2);
 
 	static SerializedRequest Prepare(uint32 size, uint32 reserveSize = 0);
 
@@ -86,6 +87,7 @@ class RequestData : public mtpBuffer {
 public:
 	explicit RequestData(const RequestConstructHider::Tag &) {
 	}
+	~RequestData();
 
 	SerializedRequest after;
 	crl::time lastSentTime = 0;
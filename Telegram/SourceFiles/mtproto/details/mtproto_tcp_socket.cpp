@@ -16,16 +16,7 @@ TcpSocket::TcpSocket(
 	const QNetworkProxy &proxy,
 	bool protocolForFiles)
 : AbstractSocket(thread) {
-	_socket.moveToThread(thread);
-	_socket.setProxy(proxy);
-	if (protocolForFiles) {
-		_socket.setSocketOption(
-			QAbstractSocket::SendBufferSizeSocketOption,
-			kFilesSendBufferSize);
-		_socket.setSocketOption(
-			QAbstractSocket::ReceiveBufferSizeSocketOption,
-			kFilesReceiveBufferSize);
-	}
+	prepareSocket(_socket, proxy, protocolForFiles);
 	const auto wrap = [&](auto handler) {
 		return [=](auto &&...args) {
 			InvokeQueued(this, [=] { handler(args...); });
@@ -35,7 +26,10 @@ TcpSocket::TcpSocket(
 	connect(
 		&_socket,
 		&QTcpSocket::connected,
-		wrap([=] { _connected.fire({}); }));
+		wrap([=] {
+			socketConnected(_socket);
+			_connected.fire({});
+		}));
 	connect(
 		&_socket,
 		&QTcpSocket::disconnected,
@@ -50,6 +44,10 @@ TcpSocket::TcpSocket(
 		wrap([=](Error e) { handleError(e); }));
 }
 
+TcpSocket::~TcpSocket() {
+	logStats(_socket);
+}
+
 void TcpSocket::connectToHost(const QString &address, int port) {
 	_socket.connectToHost(address, port);
 }
@@ -91,9 +89,11 @@ bool TcpSocket::hasBytesAvailable() {
 }
 
 int64 TcpSocket::read(bytes::span buffer) {
-	return _socket.read(
+	const auto result = _socket.read(
 		reinterpret_cast<char*>(buffer.data()),
 		buffer.size());
+	countRead(result);
+	return result;
 }
 
 void TcpSocket::write(bytes::const_span prefix, bytes::const_span buffer) {
@@ -107,6 +107,7 @@ void TcpSocket::write(bytes::const_span prefix, bytes::const_span buffer) {
 	_socket.write(
 		reinterpret_cast<const char*>(buffer.data()),
 		buffer.size());
+	countWritten(prefix.size() + buffer.size());
 }
 
 int32 TcpSocket::debugState() {
@@ -17,6 +17,7 @@ public:
 		not_null<QThread*> thread,
 		const QNetworkProxy &proxy,
 		bool protocolForFiles);
+	~TcpSocket();
 
 	void connectToHost(const QString &address, int port) override;
 	bool isGoodStartNonce(bytes::const_span nonce) override;
@@ -593,16 +593,7 @@ TlsSocket::TlsSocket(
 , _secret(secret) {
 	Expects(_secret.size() >= 21 && _secret[0] == bytes::type(0xEE));
 
-	_socket.moveToThread(thread);
-	_socket.setProxy(proxy);
-	if (protocolForFiles) {
-		_socket.setSocketOption(
-			QAbstractSocket::SendBufferSizeSocketOption,
-			kFilesSendBufferSize);
-		_socket.setSocketOption(
-			QAbstractSocket::ReceiveBufferSizeSocketOption,
-			kFilesReceiveBufferSize);
-	}
+	prepareSocket(_socket, proxy, protocolForFiles);
 	const auto wrap = [&](auto handler) {
 		return [=](auto &&...args) {
 			InvokeQueued(this, [=] { handler(args...); });
@@ -635,10 +626,15 @@ bytes::const_span TlsSocket::keyFromSecret() const {
 	return bytes::make_span(_secret).subspan(1, 16);
 }
 
+TlsSocket::~TlsSocket() {
+	logStats(_socket);
+}
+
 void TlsSocket::plainConnected() {
 	if (_state != State::Connecting) {
 		return;
 	}
+	socketConnected(_socket);
 
 	static const auto kClientHelloRules = PrepareClientHelloRules();
 	const auto hello = PrepareClientHello(
@@ -853,11 +849,11 @@ int64 TlsSocket::read(bytes::span buffer) {
 			_incomingGoodDataLimit,
 			int(_incoming.size()) - _incomingGoodDataOffset);
 		if (available <= 0) {
-			return written;
+			break;
 		}
 		const auto write = std::min(std::size_t(available), buffer.size());
 		if (write <= 0) {
-			return written;
+			break;
 		}
 		bytes::copy(
 			buffer,
@@ -869,15 +865,16 @@ int64 TlsSocket::read(bytes::span buffer) {
 		_incomingGoodDataLimit -= write;
 		_incomingGoodDataOffset += write;
 		if (_incomingGoodDataLimit) {
-			return written;
+			break;
 		}
 		shiftIncomingBy(base::take(_incomingGoodDataOffset));
 		if (!checkNextPacket()) {
 			_state = State::Error;
 			InvokeQueued(this, [=] { handleError(); });
-			return written;
+			break;
 		}
 	}
+	countRead(written);
 	return written;
 }
 
@@ -887,6 +884,7 @@ void TlsSocket::write(bytes::const_span prefix, bytes::const_span buffer) {
 	if (!isConnected()) {
 		return;
 	}
+	countWritten(prefix.size() + buffer.size());
 	if (!prefix.empty()) {
 		_socket.write(kClientPrefix.data(), kClientPrefix.size());
 	}
@@ -18,6 +18,7 @@ public:
 		const bytes::vector &secret,
 		const QNetworkProxy &proxy,
 		bool protocolForFiles);
+	~TlsSocket();
 
 	void connectToHost(const QString &address, int port) override;
 	bool isGoodStartNonce(bytes::const_span nonce) override;
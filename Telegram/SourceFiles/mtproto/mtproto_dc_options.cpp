@@ -11,6 +11,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "mtproto/facade.h"
 #include "mtproto/connection_tcp.h"
 #include "storage/serialize_common.h"
+#include "base/unixtime.h"
 
 #include <QtCore/QFile>
 #include <QtCore/QRegularExpression>
@@ -18,7 +19,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 namespace MTP {
 namespace {
 
-constexpr auto kVersion = 2;
+constexpr auto kVersion = 3;
 
 using namespace details;
 
@@ -127,6 +128,8 @@ DcOptions::DcOptions(const DcOptions &other)
 , _publicKeys(other._publicKeys)
 , _cdnPublicKeys(other._cdnPublicKeys)
 , _immutable(other._immutable) {
+	QMutexLocker lock(&other._healthMutex);
+	_health = other._health;
 }
 
 DcOptions::~DcOptions() = default;
@@ -438,6 +441,27 @@ QByteArray DcOptions::serialize() const {
 		}
 	}
 
+	// Endpoints health, only for the endpoints we still have.
+	auto health = std::vector<std::pair<EndpointId, EndpointHealth>>();
+	{
+		QMutexLocker healthLock(&_healthMutex);
+		for (const auto &[endpoint, data] : _health) {
+			const auto i = _data.find(endpoint.dcId);
+			if (i == end(_data)
+				|| !ranges::any_of(i->second, [&](const Endpoint &known) {
+					return (known.ip == endpoint.ip)
+						&& (known.port == endpoint.port);
+				})) {
+				continue;
+			}
+			health.emplace_back(endpoint, data);
+			// id + protocol + port + lastSuccess + rtt + failures
+			size += 6 * sizeof(qint32);
+			size += sizeof(qint32) + endpoint.ip.size();
+		}
+	}
+	size += sizeof(qint32);
+
 	auto result = QByteArray();
 	result.reserve(size);
 	{
@@ -471,6 +495,19 @@ QByteArray DcOptions::serialize() const {
 				<< Serialize::bytes(key.n)
 				<< Serialize::bytes(key.e);
 		}
+
+		// Endpoints health.
+		stream << qint32(health.size());
+		for (const auto &[endpoint, data] : health) {
+			stream << qint32(endpoint.dcId)
+				<< qint32(endpoint.protocol)
+				<< qint32(endpoint.port)
+				<< qint32(endpoint.ip.size());
+			stream.writeRawData(endpoint.ip.data(), endpoint.ip.size());
+			stream << qint32(data.lastSuccess)
+				<< qint32(data.rtt)
+				<< qint32(data.failures);
+		}
 	}
 	return result;
 }
@@ -566,9 +603,79 @@ bool DcOptions::constructFromSerialized(const QByteArray &serialized) {
 			}
 		}
 	}
+
+	// Read endpoints health.
+	if (!stream.atEnd() && version > 2) {
+		auto count = qint32(0);
+		stream >> count;
+		if (stream.status() != QDataStream::Ok) {
+			LOG(("MTP Error: Bad data for health in DcOptions::constructFromSerialized()"));
+			return false;
+		}
+
+		auto health = base::flat_map<EndpointId, EndpointHealth>();
+		for (auto i = 0; i != count; ++i) {
+			qint32 dcId = 0, protocol = 0, port = 0, ipSize = 0;
+			stream >> dcId >> protocol >> port >> ipSize;
+
+			constexpr auto kMaxIpSize = 45;
+			if (ipSize <= 0
+				|| ipSize > kMaxIpSize
+				|| protocol < 0
+				|| protocol >= Variants::ProtocolCount) {
+				LOG(("MTP Error: Bad data for health inside DcOptions::constructFromSerialized()"));
+				return false;
+			}
+			auto ip = std::string(ipSize, ' ');
+			stream.readRawData(ip.data(), ipSize);
+
+			qint32 lastSuccess = 0, rtt = 0, failures = 0;
+			stream >> lastSuccess >> rtt >> failures;
+			if (stream.status() != QDataStream::Ok) {
+				LOG(("MTP Error: Bad data for health inside DcOptions::constructFromSerialized()"));
+				return false;
+			}
+			health.emplace(EndpointId{
+				.dcId = DcId(dcId),
+				.protocol = Variants::Protocol(protocol),
+				.ip = std::move(ip),
+				.port = port,
+			}, EndpointHealth{
+				.lastSuccess = lastSuccess,
+				.rtt = rtt,
+				.failures = failures,
+			});
+		}
+		QMutexLocker healthLock(&_healthMutex);
+		_health = std::move(health);
+	}
 	return true;
 }
 
+void DcOptions::endpointSucceeded(
+		const EndpointId &endpoint,
+		crl::time rtt) {
+	QMutexLocker lock(&_healthMutex);
+	_health[endpoint] = EndpointHealth{
+		.lastSuccess = base::unixtime::now(),
+		.rtt = int(std::min(rtt, crl::time(std::numeric_limits<int>::max()))),
+	};
+}
+
+void DcOptions::endpointFailed(const EndpointId &endpoint) {
+	QMutexLocker lock(&_healthMutex);
+	++_health[endpoint].failures;
+}
+
+auto DcOptions::endpointHealth(const EndpointId &endpoint) const
+-> std::optional<EndpointHealth> {
+	QMutexLocker lock(&_healthMutex);
+	const auto i = _health.find(endpoint);
+	return (i != end(_health))
+		? std::make_optional(i->second)
+		: std::nullopt;
+}
+
 rpl::producer<DcId> DcOptions::changed() const {
 	return _changed.events();
 }
@@ -10,6 +10,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "base/bytes.h"
 
 #include <QtCore/QReadWriteLock>
+#include <QtCore/QMutex>
 #include <string>
 #include <vector>
 #include <map>
@@ -105,6 +106,31 @@ public:
 		bool throughProxy) const;
 	[[nodiscard]] DcType dcType(ShiftedDcId shiftedDcId) const;
 
+	struct EndpointId {
+		DcId dcId = 0;
+		Variants::Protocol protocol = Variants::Tcp;
+		std::string ip;
+		int port = 0;
+
+		friend inline auto operator<=>(
+			const EndpointId &,
+			const EndpointId &) = default;
+		friend inline bool operator==(
+			const EndpointId &,
+			const EndpointId &) = default;
+	};
+	struct EndpointHealth {
+		TimeId lastSuccess = 0;
+		int rtt = 0;
+		int failures = 0; // Since the last success.
+	};
+
+	// Thread safe.
+	void endpointSucceeded(const EndpointId &endpoint, crl::time rtt);
+	void endpointFailed(const EndpointId &endpoint);
+	[[nodiscard]] std::optional<EndpointHealth> endpointHealth(
+		const EndpointId &endpoint) const;
+
 	void setCDNConfig(const MTPDcdnConfig &config);
 	[[nodiscard]] bool hasCDNKeysForDc(DcId dcId) const;
 	[[nodiscard]] details::RSAPublicKey getDcRSAKey(
@@ -155,6 +181,8 @@ private:
 		DcId,
 		base::flat_map<uint64, details::RSAPublicKey>> _cdnPublicKeys;
 	mutable QReadWriteLock _useThroughLockers;
+	base::flat_map<EndpointId, EndpointHealth> _health;
+	mutable QMutex _healthMutex;
 
 	rpl::event_stream<DcId> _changed;
 	rpl::event_stream<> _cdnConfigChanged;
@@ -9,6 +9,8 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 
 #include <QtCore/QRegularExpression>
 
+#include <chrono>
+
 namespace MTP {
 namespace {
 
@@ -70,6 +72,19 @@ MTPrpcError Error::MTPLocal(
 					: QString())).toUtf8()));
 }
 
+int64 details::ParseStarted() {
+	using namespace std::chrono;
+	return duration_cast<microseconds>(
+		steady_clock::now().time_since_epoch()).count();
+}
+
+void details::LogParsed(const mtpBuffer &reply, int64 started) {
+	DEBUG_LOG(("MTP Parse: %1 KB of type %2 in %3 mcs."
+		).arg(reply.size() * sizeof(mtpPrime) / 1024
+		).arg(reply.isEmpty() ? 0 : mtpTypeId(reply[0]), 0, 16
+		).arg(ParseStarted() - started));
+}
+
 Error Error::Local(
 		const QString &type,
 		const QString &description) {
@@ -60,6 +60,30 @@ struct Response {
 	mtpRequestId requestId = 0;
 };
 
+namespace details {
+
+inline constexpr auto kLargeResponseInts = 16 * 1024;
+
+[[nodiscard]] int64 ParseStarted();
+void LogParsed(const mtpBuffer &reply, int64 started);
+
+} // namespace details
+
+// Parsing time of large responses, like history slices or differences,
+// is written to the debug log, it is spent on allocating MTP* types.
+template <typename Result>
+[[nodiscard]] bool ReadResponse(Result &result, const mtpBuffer &reply) {
+	auto from = reply.constData();
+	const auto till = from + reply.size();
+	if (reply.size() < details::kLargeResponseInts) {
+		return result.read(from, till);
+	}
+	const auto started = details::ParseStarted();
+	const auto read = result.read(from, till);
+	details::LogParsed(reply, started);
+	return read;
+}
+
 using DoneHandler = FnMut<bool(const Response&)>;
 using FailHandler = Fn<bool(const Error&, const Response&)>;
 
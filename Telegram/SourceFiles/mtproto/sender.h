@@ -46,8 +46,7 @@ class Sender {
 				sender->senderRequestHandled(response.requestId);
 
 				auto result = Result();
-				auto from = response.reply.constData();
-				if (!result.read(from, from + response.reply.size())) {
+				if (!ReadResponse(result, response.reply)) {
 					return false;
 				} else if (!onstack) {
 					return true;
@@ -30,6 +30,7 @@ namespace {
 
 constexpr auto kIntSize = static_cast<int>(sizeof(mtpPrime));
 constexpr auto kWaitForBetterTimeout = crl::time(2000);
+constexpr auto kFailedEndpointPriorityPenalty = 4;
 constexpr auto kMinConnectedTimeout = crl::time(1000);
 constexpr auto kMaxConnectedTimeout = crl::time(8000);
 constexpr auto kMinReceiveTimeout = crl::time(4000);
@@ -185,9 +186,23 @@ void SessionPrivate::appendTestConnection(
 		const bytes::vector &protocolSecret) {
 	QWriteLocker lock(&_stateMutex);
 
+	// Health through a proxy says nothing about the endpoint itself.
+	auto endpoint = DcOptions::EndpointId{
+		.dcId = BareDcId(_shiftedDcId),
+		.protocol = protocol,
+		.ip = _options->proxy ? std::string() : ip.toStdString(),
+		.port = port,
+	};
+	const auto health = endpoint.ip.empty()
+		? std::nullopt
+		: _instance->dcOptions().endpointHealth(endpoint);
+
+	// Don't wait for a better connection that failed the last time.
+	const auto failed = health && (health->failures > 0);
 	const auto priority = (qthelp::is_ipv6(ip) ? 0 : 1)
 		+ (protocol == DcOptions::Variants::Tcp ? 1 : 0)
-		+ (protocolSecret.empty() ? 0 : 1);
+		+ (protocolSecret.empty() ? 0 : 1)
+		- (failed ? kFailedEndpointPriorityPenalty : 0);
 	_testConnections.push_back({
 		AbstractConnection::Create(
 			_instance,
@@ -195,7 +210,9 @@ void SessionPrivate::appendTestConnection(
 			thread(),
 			protocolSecret,
 			_options->proxy),
-		priority
+		priority,
+		std::move(endpoint),
+		crl::now(),
 	});
 	const auto weak = _testConnections.back().data.get();
 	connect(weak, &AbstractConnection::error, [=](int errorCode) {
@@ -825,7 +842,9 @@ void SessionPrivate::tryToSend() {
 			// prepare container + each in invoke after
 			toSendRequest = SerializedRequest::Prepare(
 				containerSize,
-				containerSize + 3 * toSend.size());
+				(containerSize
+					+ 3 * toSend.size()
+					+ SerializedRequest::kMaxPaddingInts));
 			toSendRequest->push_back(mtpc_msg_container);
 			toSendRequest->push_back(toSendCount);
 
@@ -1398,7 +1417,12 @@ void SessionPrivate::handleReceived() {
 		}
 		_retryTimeout = 1; // reset restart() timer
 
-		_startedConnectingAt = crl::time(0);
+		if (const auto started = base::take(_startedConnectingAt)) {
+			DEBUG_LOG(("MTP Info: first response from dc %1 "
+				"in %2 ms after starting to connect."
+				).arg(_shiftedDcId
+				).arg(crl::now() - started));
+		}
 
 		if (!wasConnected) {
 			if (getState() == ConnectedState) {
@@ -2275,6 +2299,11 @@ void SessionPrivate::onConnected(
 		connection.get(),
 		[](const TestConnection &test) { return test.data.get(); });
 	Assert(i != end(_testConnections));
+	if (!i->endpoint.ip.empty()) {
+		_instance->dcOptions().endpointSucceeded(
+			i->endpoint,
+			crl::now() - i->started);
+	}
 	const auto my = i->priority;
 	const auto j = ranges::find_if(
 		_testConnections,
@@ -2331,6 +2360,13 @@ void SessionPrivate::confirmBestConnection() {
 
 void SessionPrivate::removeTestConnection(
 		not_null<AbstractConnection*> connection) {
+	const auto i = ranges::find(
+		_testConnections,
+		connection.get(),
+		[](const TestConnection &test) { return test.data.get(); });
+	if (i != end(_testConnections) && !i->endpoint.ip.empty()) {
+		_instance->dcOptions().endpointFailed(i->endpoint);
+	}
 	_testConnections.erase(
 		ranges::remove(
 			_testConnections,
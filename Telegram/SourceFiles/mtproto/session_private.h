@@ -56,6 +56,8 @@ private:
 	struct TestConnection {
 		ConnectionPointer data;
 		int priority = 0;
+		DcOptions::EndpointId endpoint;
+		crl::time started = 0;
 	};
 	struct SentContainer {
 		crl::time sent = 0;
@@ -32,6 +32,7 @@ constexpr auto kMaxTrackedSuccesses = kRetryAddSessionSuccesses
 constexpr auto kRemoveSessionAfterTimeouts = 4;
 constexpr auto kResetDownloadPrioritiesTimeout = crl::time(200);
 constexpr auto kBadRequestDurationThreshold = 8 * crl::time(1000);
+constexpr auto kMaxTrackedDurations = 4096;
 
 // Each (session remove by timeouts) we wait for time:
 // kRetryAddSessionTimeout * max(removesCount, kMaxTrackedSessionRemoves)
@@ -152,6 +153,18 @@ void DownloadManagerMtproto::remove(not_null<Task*> task) {
 	checkSendNext(dcId, queue);
 }
 
+void DownloadManagerMtproto::prewarm(MTP::DcId dcId) {
+	if (_balanceData.contains(dcId)) {
+		return;
+	}
+	DEBUG_LOG(("Download (%1) prewarming.").arg(dcId));
+	_balanceData.emplace(dcId, DcBalanceData());
+	api().instance().sendAnything(MTP::downloadDcId(dcId, 0));
+
+	// The session is stopped as any other idle one, the keys are kept.
+	killSessionsSchedule(dcId);
+}
+
 void DownloadManagerMtproto::resetGeneration() {
 	_resetGenerationTimer.cancel();
 	for (auto &[dcId, queue] : _queues) {
@@ -230,7 +243,8 @@ void DownloadManagerMtproto::requestSucceeded(
 		MTP::DcId dcId,
 		int index,
 		int amountAtRequestStart,
-		crl::time timeAtRequestStart) {
+		crl::time timeAtRequestStart,
+		int receivedBytes) {
 	using namespace rpl::mappers;
 
 	const auto i = _balanceData.find(dcId);
@@ -242,6 +256,15 @@ void DownloadManagerMtproto::requestSucceeded(
 		|| (amountAtRequestStart > data.maxWaitedAmount);
 	const auto parts = amountAtRequestStart / kDownloadPartSize;
 	const auto duration = (crl::now() - timeAtRequestStart);
+	if (dc.durations.size() < kMaxTrackedDurations) {
+		dc.durations.push_back(duration);
+	}
+	++dc.requestsFinished;
+	dc.receivedBytes += receivedBytes;
+	if (!dc.firstRequestStarted) {
+		dc.firstRequestStarted = timeAtRequestStart;
+	}
+	dc.lastRequestFinished = crl::now();
 	DEBUG_LOG(("Download (%1,%2) request done, duration: %3, parts: %4%5"
 		).arg(dcId
 		).arg(index
@@ -400,6 +423,7 @@ void DownloadManagerMtproto::killSessions(MTP::DcId dcId) {
 	if (i != end(_balanceData)) {
 		auto &dc = i->second;
 		Assert(dc.totalRequested == 0);
+		logStats(dcId, dc);
 		auto sessions = base::take(dc.sessions);
 		dc = DcBalanceData();
 		for (auto j = 0; j != int(sessions.size()); ++j) {
@@ -411,6 +435,31 @@ void DownloadManagerMtproto::killSessions(MTP::DcId dcId) {
 	}
 }
 
+void DownloadManagerMtproto::logStats(
+		MTP::DcId dcId,
+		const DcBalanceData &dc) const {
+	if (dc.durations.empty()) {
+		return;
+	}
+	auto sorted = dc.durations;
+	ranges::sort(sorted);
+	const auto percentile = [&](int value) {
+		return sorted[(sorted.size() - 1) * value / 100];
+	};
+	const auto elapsed = std::max(
+		dc.lastRequestFinished - dc.firstRequestStarted,
+		crl::time(1));
+	DEBUG_LOG(("Download (%1) stats: %2 parts in %3 ms, %4 KB/s, "
+		"latency p50 %5 ms, p90 %6 ms, p99 %7 ms."
+		).arg(dcId
+		).arg(dc.requestsFinished
+		).arg(elapsed
+		).arg(dc.receivedBytes * 1000 / (elapsed * 1024)
+		).arg(percentile(50)
+		).arg(percentile(90)
+		).arg(percentile(99)));
+}
+
 DownloadMtprotoTask::DownloadMtprotoTask(
 	not_null<DownloadManagerMtproto*> owner,
 	const StorageFileLocation &location,
@@ -621,9 +670,15 @@ void DownloadMtprotoTask::requestMoreCdnFileHashes() {
 void DownloadMtprotoTask::normalPartLoaded(
 		const MTPupload_File &result,
 		mtpRequestId requestId) {
+	const auto received = result.match([](const MTPDupload_file &data) {
+		return int(data.vbytes().v.size());
+	}, [](const MTPDupload_fileCdnRedirect &) {
+		return 0;
+	});
 	const auto requestData = finishSentRequest(
 		requestId,
-		FinishRequestReason::Success);
+		FinishRequestReason::Success,
+		received);
 	const auto owner = _owner;
 	const auto dcId = this->dcId();
 	result.match([&](const MTPDupload_fileCdnRedirect &data) {
@@ -641,7 +696,8 @@ void DownloadMtprotoTask::webPartLoaded(
 		mtpRequestId requestId) {
 	const auto requestData = finishSentRequest(
 		requestId,
-		FinishRequestReason::Success);
+		FinishRequestReason::Success,
+		int(result.data().vbytes().v.size()));
 	const auto owner = _owner;
 	const auto dcId = this->dcId();
 	result.match([&](const MTPDupload_webFile &data) {
@@ -674,7 +730,8 @@ void DownloadMtprotoTask::cdnPartLoaded(const MTPupload_CdnFile &result, mtpRequ
 	}, [&](const MTPDupload_cdnFile &data) {
 		const auto requestData = finishSentRequest(
 			requestId,
-			FinishRequestReason::Success);
+			FinishRequestReason::Success,
+			int(data.vbytes().v.size()));
 		const auto owner = _owner;
 		const auto dcId = this->dcId();
 		const auto guard = gsl::finally([=] {
@@ -817,7 +874,8 @@ void DownloadMtprotoTask::placeSentRequest(
 
 auto DownloadMtprotoTask::finishSentRequest(
 	mtpRequestId requestId,
-	FinishRequestReason reason)
+	FinishRequestReason reason,
+	int receivedBytes)
 -> RequestData {
 	auto it = _sentRequests.find(requestId);
 	Assert(it != _sentRequests.cend());
@@ -838,7 +896,8 @@ auto DownloadMtprotoTask::finishSentRequest(
 			dcId(),
 			result.sessionIndex,
 			result.requestedInSession,
-			result.sent);
+			result.sent,
+			receivedBytes);
 	}
 
 	Ensures(ok);
@@ -41,6 +41,10 @@ public:
 	void enqueue(not_null<Task*> task, int priority);
 	void remove(not_null<Task*> task);
 
+	// Starts a download session for a dc that wasn't used yet, so that
+	// its keys are created before the first file is requested from it.
+	void prewarm(MTP::DcId dcId);
+
 	void notifyTaskFinished() {
 		_taskFinished.fire({});
 	}
@@ -53,7 +57,8 @@ public:
 		MTP::DcId dcId,
 		int index,
 		int amountAtRequestStart,
-		crl::time timeAtRequestStart);
+		crl::time timeAtRequestStart,
+		int receivedBytes);
 	void checkSendNextAfterSuccess(MTP::DcId dcId);
 	[[nodiscard]] int chooseSessionIndex(MTP::DcId dcId) const;
 
@@ -91,6 +96,14 @@ private:
 		int sessionRemoveTimes = 0;
 		int timeouts = 0; // Since all sessions had successes >= required.
 		int totalRequested = 0;
+
+		// Finished requests since the sessions were started, for the log.
+		// Latencies are tracked up to a limit, the totals are not capped.
+		std::vector<crl::time> durations;
+		int requestsFinished = 0;
+		int64 receivedBytes = 0;
+		crl::time firstRequestStarted = 0;
+		crl::time lastRequestFinished = 0;
 	};
 
 	void checkSendNext();
@@ -101,6 +114,7 @@ private:
 	void killSessionsCancel(MTP::DcId dcId);
 	void killSessions();
 	void killSessions(MTP::DcId dcId);
+	void logStats(MTP::DcId dcId, const DcBalanceData &dc) const;
 
 	void resetGeneration();
 	void sessionTimedOut(MTP::DcId dcId, int index);
@@ -236,7 +250,8 @@ private:
 		const RequestData &requestData);
 	[[nodiscard]] RequestData finishSentRequest(
 		mtpRequestId requestId,
-		FinishRequestReason reason);
+		FinishRequestReason reason,
+		int receivedBytes = 0);
 	void switchToCDN(
 		const RequestData &requestData,
 		const MTPDupload_fileCdnRedirect &redirect);
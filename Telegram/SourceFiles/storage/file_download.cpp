@@ -15,16 +15,33 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "core/application.h"
 #include "core/file_location.h"
 #include "storage/storage_account.h"
+#include "storage/storage_cache_stats.h"
 #include "storage/file_download_mtproto.h"
 #include "storage/file_download_web.h"
 #include "platform/platform_file_utilities.h"
+#include "main/main_account.h"
+#include "main/main_domain.h"
 #include "main/main_session.h"
 #include "apiwrap.h"
 #include "core/crash_reports.h"
 #include "base/bytes.h"
+#include "base/options.h"
 
 namespace {
 
+base::options::toggle ShareCacheBetweenAccounts({
+	.id = Storage::kOptionShareCacheBetweenAccounts,
+	.name = "Share media cache between accounts",
+	.description = "Look for media files in the caches of other accounts "
+		"before downloading them again.",
+});
+
+struct SharedCacheStats {
+	int64 files = 0;
+	int64 bytes = 0;
+};
+SharedCacheStats SharedCacheTotal;
+
 class FromMemoryLoader final : public FileLoader {
 public:
 	FromMemoryLoader(
@@ -90,6 +107,9 @@ void FromMemoryLoader::startLoading() {
 
 } // namespace
 
+const char Storage::kOptionShareCacheBetweenAccounts[]
+	= "share-cache-between-accounts";
+
 FileLoader::FileLoader(
 	not_null<Main::Session*> session,
 	const QString &toFile,
@@ -210,12 +230,37 @@ void FileLoader::localLoaded(
 		const QByteArray &imageFormat,
 		const QImage &imageData) {
 	_localLoading = nullptr;
-	if (result.data.isEmpty()) {
+	const auto shared = (_sharedCacheAttempt > 0);
+	const auto partial = result.data.startsWith("partial:");
+	if (!shared) {
+		_session->data().cacheStats()->read(
+			Storage::CacheStats::TagFromCacheTag(_cacheTag),
+			result.data.size());
+	}
+
+	// Only complete values of the expected size are taken from the caches
+	// of other accounts, partial ones are continued in our own cache.
+	const auto bad = shared
+		&& (partial || (_fullSize && result.data.size() != _fullSize));
+	if (result.data.isEmpty() || bad) {
+		if (tryLoadShared()) {
+			return;
+		}
 		_localStatus = LocalStatus::NotFound;
 		start();
 		return;
 	}
-	const auto partial = result.data.startsWith("partial:");
+	if (shared) {
+		// The value is not put to our own cache, so the same bytes are
+		// not stored on disk twice and not downloaded once more.
+		++SharedCacheTotal.files;
+		SharedCacheTotal.bytes += result.data.size();
+		DEBUG_LOG(("Shared Cache: Got %1 bytes from another account, "
+			"saved %2 bytes of traffic and disk space in %3 files."
+			).arg(result.data.size()
+			).arg(SharedCacheTotal.bytes
+			).arg(SharedCacheTotal.files));
+	}
 	constexpr auto kPrefix = 8;
 	if (partial	&& result.data.size() < _loadSize + kPrefix) {
 		_localStatus = LocalStatus::NotFound;
@@ -263,6 +308,48 @@ bool FileLoader::checkForOpen() {
 }
 
 void FileLoader::loadLocal(const Storage::Cache::Key &key) {
+	loadLocal(key, &_session->data().cache());
+}
+
+bool FileLoader::tryLoadShared() {
+	if (_toCache != LoadToCacheAsWell) {
+		return false;
+	}
+	const auto key = cacheKey();
+	if (!key.low && !key.high) {
+		return false;
+	} else if (const auto cache = nextSharedCache()) {
+		loadLocal(key, cache);
+		return true;
+	}
+	return false;
+}
+
+Storage::Cache::Database *FileLoader::nextSharedCache() {
+	if (!ShareCacheBetweenAccounts.value()) {
+		return nullptr;
+	}
+	const auto testMode = _session->isTestMode();
+	auto tried = 0;
+	for (const auto &[index, account] : _session->domain().accounts()) {
+		if (!account->sessionExists()) {
+			continue;
+		}
+		const auto session = &account->session();
+		if (session == _session
+			|| session->isTestMode() != testMode) {
+			continue;
+		} else if (tried++ == _sharedCacheAttempt) {
+			++_sharedCacheAttempt;
+			return &session->data().cache();
+		}
+	}
+	return nullptr;
+}
+
+void FileLoader::loadLocal(
+		const Storage::Cache::Key &key,
+		not_null<Storage::Cache::Database*> cache) {
 	const auto readImage = (_locationType != AudioFileLocation);
 	auto done = [=, guard = _localLoading.make_guard()](
 			QByteArray &&value,
@@ -280,7 +367,7 @@ void FileLoader::loadLocal(const Storage::Cache::Key &key) {
 				std::move(image));
 		});
 	};
-	_session->data().cache().get(key, [=, callback = std::move(done)](
+	cache->get(key, [=, callback = std::move(done)](
 			QByteArray &&value) mutable {
 		if (readImage && !value.startsWith("partial:")) {
 			crl::async([
@@ -458,12 +545,16 @@ bool FileLoader::finalizeResult() {
 		if ((_toCache == LoadToCacheAsWell)
 			&& (_data.size() <= Storage::kMaxFileInMemory)
 			&& (key.low || key.high)) {
+			auto value = base::duplicate((!_fullSize || _data.size() == _fullSize)
+				? _data
+				: ("partial:" + _data));
+			_session->data().cacheStats()->written(
+				Storage::CacheStats::TagFromCacheTag(_cacheTag),
+				value.size());
 			_session->data().cache().put(
 				cacheKey(),
 				Storage::Cache::Database::TaggedValue(
-					base::duplicate((!_fullSize || _data.size() == _fullSize)
-						? _data
-						: ("partial:" + _data)),
+					std::move(value),
 					_cacheTag));
 		}
 	}
@@ -23,8 +23,11 @@ class Session;
 namespace Storage {
 namespace Cache {
 struct Key;
+class Database;
 } // namespace Cache
 
+extern const char kOptionShareCacheBetweenAccounts[];
+
 // 10 MB max file could be hold in memory
 // This value is used in local cache database settings!
 constexpr auto kMaxFileInMemory = 10 * 1024 * 1024;
@@ -145,6 +148,11 @@ protected:
 	bool checkForOpen();
 	bool tryLoadLocal();
 	void loadLocal(const Storage::Cache::Key &key);
+	void loadLocal(
+		const Storage::Cache::Key &key,
+		not_null<Storage::Cache::Database*> cache);
+	bool tryLoadShared();
+	[[nodiscard]] Storage::Cache::Database *nextSharedCache();
 	virtual Storage::Cache::Key cacheKey() const = 0;
 	virtual std::optional<MediaKey> fileLocationKey() const = 0;
 	virtual void cancelHook() = 0;
@@ -184,6 +192,7 @@ protected:
 	LocationType _locationType = LocationType();
 
 	base::binary_guard _localLoading;
+	int _sharedCacheAttempt = 0;
 	mutable QByteArray _imageFormat;
 	mutable QImage _imageData;
 
@@ -22,6 +22,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "core/mime_type.h"
 #include "main/main_session.h"
 #include "apiwrap.h"
+#include "base/random.h"
 
 namespace Storage {
 namespace {
@@ -46,6 +47,12 @@ constexpr auto kDocumentUploadPartSize3 = 256 * 1024;
 // 512kb for large document ( <= 1500mb )
 constexpr auto kDocumentUploadPartSize4 = 512 * 1024;
 
+// All parts of a file uploaded while it is being written have this size.
+constexpr auto kStreamedPartSize = kDocumentUploadPartSize0;
+
+// Files uploaded while being written that weren't sent in that time.
+constexpr auto kStreamedExpireTimeout = 60 * crl::time(1000);
+
 // One part each half second, if not uploaded faster.
 constexpr auto kUploadRequestInterval = crl::time(500);
 
@@ -83,6 +90,20 @@ struct Uploader::File {
 	int docSentParts = 0;
 	int docPartsCount = 0;
 
+	int streamedParts = 0;
+	crl::time streamedAttached = 0;
+
+};
+
+struct Uploader::Streamed {
+	QByteArray pending;
+	int64 size = 0;
+	int partsSent = 0;
+	HashMd5 md5;
+	base::flat_set<mtpRequestId> requests;
+	crl::time updated = 0;
+	bool failed = false;
+	bool attached = false;
 };
 
 Uploader::File::File(const SendMediaReady &media) : media(media) {
@@ -153,7 +174,8 @@ const QString &Uploader::File::filename() const {
 Uploader::Uploader(not_null<ApiWrap*> api)
 : _api(api)
 , _nextTimer([=] { sendNext(); })
-, _stopSessionsTimer([=] { stopSessions(); }) {
+, _stopSessionsTimer([=] { stopSessions(); })
+, _streamedExpireTimer([=] { expireStreamed(); }) {
 	const auto session = &_api->session();
 	photoReady(
 	) | rpl::start_with_next([=](UploadedMedia &&data) {
@@ -352,10 +374,173 @@ void Uploader::upload(
 			document->checkWallPaperProperties();
 		}
 	}
-	queue.emplace(msgId, File(file));
+	auto &added = queue.emplace(msgId, File(file)).first->second;
+	attachStreamed(added);
+	sendNext();
+}
+
+uint64 Uploader::streamStart() {
+	const auto id = base::RandomValue<uint64>();
+	_streamed.emplace(id, Streamed{ .updated = crl::now() });
+	_stopSessionsTimer.cancel();
+	if (!_streamedExpireTimer.isActive()) {
+		_streamedExpireTimer.callOnce(kStreamedExpireTimeout);
+	}
+	return id;
+}
+
+void Uploader::streamAppend(
+		uint64 id,
+		int64 offset,
+		const QByteArray &bytes) {
+	const auto i = _streamed.find(id);
+	if (i == end(_streamed) || i->second.failed || i->second.attached) {
+		return;
+	}
+	auto &streamed = i->second;
+	if (offset != streamed.size
+		|| streamed.size + bytes.size() > kUseBigFilesFrom) {
+		// The file will be uploaded the usual way after it is written.
+		streamed.failed = true;
+		return;
+	}
+	streamed.size += bytes.size();
+	streamed.pending.append(bytes);
+	streamed.updated = crl::now();
+	streamSendParts(id, streamed);
+}
+
+void Uploader::streamSendParts(uint64 id, Streamed &streamed) {
+	auto sent = 0;
+	while (streamed.pending.size() - sent >= kStreamedPartSize) {
+		const auto part = streamed.pending.mid(sent, kStreamedPartSize);
+		sent += kStreamedPartSize;
+		streamed.md5.feed(part.constData(), part.size());
+		const auto requestId = _api->request(MTPupload_SaveFilePart(
+			MTP_long(id),
+			MTP_int(streamed.partsSent),
+			MTP_bytes(part)
+		)).done([=](const MTPBool &result, mtpRequestId requestId) {
+			streamPartDone(id, requestId, mtpIsTrue(result));
+		}).fail([=](const MTP::Error &error, mtpRequestId requestId) {
+			streamPartDone(id, requestId, false);
+		}).toDC(MTP::uploadDcId(0)).send();
+		streamed.requests.emplace(requestId);
+		++streamed.partsSent;
+	}
+	if (sent > 0) {
+		streamed.pending.remove(0, sent);
+	}
+}
+
+void Uploader::streamPartDone(
+		uint64 id,
+		mtpRequestId requestId,
+		bool success) {
+	const auto i = _streamed.find(id);
+	if (i == end(_streamed)) {
+		return;
+	}
+	auto &streamed = i->second;
+	streamed.requests.remove(requestId);
+	if (!success) {
+		streamed.failed = true;
+	}
+	if (!streamed.attached) {
+		return;
+	} else if (streamed.failed) {
+		// Upload the attached file from the beginning.
+		for (const auto request : base::take(streamed.requests)) {
+			_api->request(request).cancel();
+		}
+		for (auto &[fullId, file] : queue) {
+			if (file.id() == id) {
+				file.docSentParts = 0;
+				file.md5Hash = HashMd5();
+				file.streamedParts = 0;
+			}
+		}
+	}
+	if (streamed.requests.empty()) {
+		_streamed.erase(i);
+	}
+	sendNext();
+}
+
+void Uploader::streamCancel(uint64 id) {
+	const auto i = _streamed.find(id);
+	if (i == end(_streamed) || i->second.attached) {
+		return;
+	}
+	for (const auto requestId : i->second.requests) {
+		_api->request(requestId).cancel();
+	}
+	_streamed.erase(i);
+	sendNext();
+}
+
+void Uploader::expireStreamed() {
+	// If the written file never reaches upload(), for example if the
+	// sending was cancelled, the stream is dropped after a while.
+	const auto now = crl::now();
+	auto next = crl::time(0);
+	for (auto i = begin(_streamed); i != end(_streamed);) {
+		auto &streamed = i->second;
+		if (streamed.attached) {
+			++i;
+		} else if (streamed.updated + kStreamedExpireTimeout <= now) {
+			for (const auto requestId : streamed.requests) {
+				_api->request(requestId).cancel();
+			}
+			i = _streamed.erase(i);
+		} else {
+			const auto left = streamed.updated + kStreamedExpireTimeout - now;
+			if (!next || next > left) {
+				next = left;
+			}
+			++i;
+		}
+	}
+	if (next) {
+		_streamedExpireTimer.callOnce(next);
+	}
 	sendNext();
 }
 
+void Uploader::attachStreamed(File &file) {
+	const auto i = _streamed.find(file.id());
+	if (i == end(_streamed)) {
+		return;
+	}
+	auto &streamed = i->second;
+	if (streamed.failed
+		|| !file.file
+		|| file.type() != SendMediaType::Audio
+		|| file.docSize > kUseBigFilesFrom
+		|| file.docSize < streamed.size
+		|| !file.setPartSize(kStreamedPartSize)) {
+		for (const auto requestId : streamed.requests) {
+			_api->request(requestId).cancel();
+		}
+		_streamed.erase(i);
+		file.setDocSize(file.docSize);
+		return;
+	}
+	streamed.attached = true;
+	file.docSentParts = streamed.partsSent;
+	file.md5Hash = streamed.md5;
+	file.streamedParts = streamed.partsSent;
+	file.streamedAttached = crl::now();
+	if (streamed.requests.empty()) {
+		_streamed.erase(i);
+	}
+}
+
+bool Uploader::streamedRequestsInFlight(uint64 id) const {
+	const auto i = _streamed.find(id);
+	return (i != end(_streamed)) && !i->second.requests.empty();
+}
+
 void Uploader::currentFailed() {
 	auto j = queue.find(uploadingId);
 	if (j != queue.end()) {
@@ -407,7 +592,7 @@ void Uploader::sendNext() {
 
 	const auto stopping = _stopSessionsTimer.isActive();
 	if (queue.empty()) {
-		if (!stopping) {
+		if (!stopping && _streamed.empty()) {
 			_stopSessionsTimer.callOnce(kKillSessionTimeout);
 		}
 		return;
@@ -446,7 +631,9 @@ void Uploader::sendNext() {
 		: uploadingData.media.thumbId;
 	if (parts.isEmpty()) {
 		if (uploadingData.docSentParts >= uploadingData.docPartsCount) {
-			if (requestsSent.empty() && docRequestsSent.empty()) {
+			if (requestsSent.empty()
+				&& docRequestsSent.empty()
+				&& !streamedRequestsInFlight(uploadingData.id())) {
 				const auto options = uploadingData.file
 					? uploadingData.file->to.options
 					: Api::SendOptions();
@@ -512,6 +699,14 @@ void Uploader::sendNext() {
 							MTP_string(thumbFilename),
 							MTP_bytes(thumbMd5));
 					}();
+					if (const auto attached = uploadingData.streamedAttached) {
+						DEBUG_LOG(("Uploader: Streamed file ready in %1 ms "
+							"after it was written, %2 of %3 parts were sent "
+							"in advance."
+							).arg(crl::now() - attached
+							).arg(uploadingData.streamedParts
+							).arg(uploadingData.docPartsCount));
+					}
 					_documentReady.fire({
 						.fullId = uploadingId,
 						.info = {
@@ -673,6 +868,11 @@ void Uploader::cancelRequests() {
 
 void Uploader::clear() {
 	queue.clear();
+	for (const auto &[id, streamed] : base::take(_streamed)) {
+		for (const auto requestId : streamed.requests) {
+			_api->request(requestId).cancel();
+		}
+	}
 	cancelRequests();
 	dcMap.clear();
 	sentSize = 0;
@@ -67,6 +67,12 @@ public:
 	void pause(const FullMsgId &msgId);
 	void confirm(const FullMsgId &msgId);
 
+	// Upload the parts of a file while it is still being written.
+	// Pass the returned id as the file id of the final upload() call.
+	[[nodiscard]] uint64 streamStart();
+	void streamAppend(uint64 id, int64 offset, const QByteArray &bytes);
+	void streamCancel(uint64 id);
+
 	void cancelAll();
 	void clear();
 
@@ -104,6 +110,13 @@ public:
 
 private:
 	struct File;
+	struct Streamed;
+
+	void streamSendParts(uint64 id, Streamed &streamed);
+	void streamPartDone(uint64 id, mtpRequestId requestId, bool success);
+	void attachStreamed(File &file);
+	void expireStreamed();
+	[[nodiscard]] bool streamedRequestsInFlight(uint64 id) const;
 
 	void partLoaded(const MTPBool &result, mtpRequestId requestId);
 	void partFailed(const MTP::Error &error, mtpRequestId requestId);
@@ -132,7 +145,9 @@ private:
 	FullMsgId uploadingId;
 	FullMsgId _pausedId;
 	std::map<FullMsgId, File> queue;
+	std::map<uint64, Streamed> _streamed;
 	base::Timer _nextTimer, _stopSessionsTimer;
+	base::Timer _streamedExpireTimer;
 
 	rpl::event_stream<UploadedMedia> _photoReady;
 	rpl::event_stream<UploadedMedia> _documentReady;
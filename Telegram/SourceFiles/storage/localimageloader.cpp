@@ -580,8 +580,9 @@ FileLoadTask::FileLoadTask(
 	int32 duration,
 	const VoiceWaveform &waveform,
 	const FileLoadTo &to,
-	const TextWithTags &caption)
-: _id(base::RandomValue<uint64>())
+	const TextWithTags &caption,
+	uint64 fileId)
+: _id(fileId ? fileId : base::RandomValue<uint64>())
 , _session(session)
 , _dcId(session->mainDcId())
 , _to(to)
@@ -299,7 +299,8 @@ public:
 		int32 duration,
 		const VoiceWaveform &waveform,
 		const FileLoadTo &to,
-		const TextWithTags &caption);
+		const TextWithTags &caption,
+		uint64 fileId = 0);
 	~FileLoadTask();
 
 	uint64 fileid() const {
@@ -60,6 +60,10 @@ constexpr auto kMultiDraftCursorsTagOld = quint64(0xFFFF'FFFF'FFFF'FF02ULL);
 constexpr auto kMultiDraftTag = quint64(0xFFFF'FFFF'FFFF'FF03ULL);
 constexpr auto kMultiDraftCursorsTag = quint64(0xFFFF'FFFF'FFFF'FF04ULL);
 
+constexpr char kDraftsJournalMagic[] = { 'T', 'D', 'J', '$' };
+constexpr auto kDraftsJournalMagicLen = int(sizeof(kDraftsJournalMagic));
+constexpr auto kDraftsJournalCompactSize = qint64(256 * 1024);
+
 enum { // Local Storage Keys
 	lskUserMap = 0x00,
 	lskDraft = 0x01, // data: PeerId peer
@@ -85,6 +89,8 @@ enum { // Local Storage Keys
 	lskSelfSerialized = 0x15, // serialized self
 	lskMasksKeys = 0x16, // no data
 	lskCustomEmojiKeys = 0x17, // no data
+	lskChatListSnapshot = 0x18, // no data
+	lskDraftsJournal = 0x19, // no data
 };
 
 auto EmptyMessageDraftSources()
@@ -207,6 +213,8 @@ base::flat_set<QString> Account::collectGoodNames() const {
 		_installedCustomEmojiKey,
 		_featuredCustomEmojiKey,
 		_archivedCustomEmojiKey,
+		_chatListSnapshotKey,
+		_draftsJournalKey,
 	};
 	auto result = base::flat_set<QString>{
 		"map0",
@@ -292,6 +300,8 @@ Account::ReadMapResult Account::readMapWith(
 	quint64 savedGifsKey = 0;
 	quint64 legacyBackgroundKeyDay = 0, legacyBackgroundKeyNight = 0;
 	quint64 userSettingsKey = 0, recentHashtagsAndBotsKey = 0, exportSettingsKey = 0;
+	quint64 chatListSnapshotKey = 0;
+	quint64 draftsJournalKey = 0;
 	while (!map.stream.atEnd()) {
 		quint32 keyType;
 		map.stream >> keyType;
@@ -397,6 +407,12 @@ Account::ReadMapResult Account::readMapWith(
 				>> featuredCustomEmojiKey
 				>> archivedCustomEmojiKey;
 		} break;
+		case lskChatListSnapshot: {
+			map.stream >> chatListSnapshotKey;
+		} break;
+		case lskDraftsJournal: {
+			map.stream >> draftsJournalKey;
+		} break;
 		default:
 			LOG(("App Error: unknown key type in encrypted map: %1").arg(keyType));
 			return ReadMapResult::Failed;
@@ -432,6 +448,8 @@ Account::ReadMapResult Account::readMapWith(
 	_settingsKey = userSettingsKey;
 	_recentHashtagsAndBotsKey = recentHashtagsAndBotsKey;
 	_exportSettingsKey = exportSettingsKey;
+	_chatListSnapshotKey = chatListSnapshotKey;
+	_draftsJournalKey = draftsJournalKey;
 	_oldMapVersion = mapData.version;
 
 	if (_oldMapVersion < AppVersion) {
@@ -443,6 +461,9 @@ Account::ReadMapResult Account::readMapWith(
 	if (_locationsKey) {
 		readLocations();
 	}
+	if (_draftsJournalKey) {
+		readDraftsJournal();
+	}
 	if (_legacyBackgroundKeyDay || _legacyBackgroundKeyNight) {
 		Local::moveLegacyBackground(
 			_basePath,
@@ -489,8 +510,20 @@ void Account::writeMap() {
 	if (!QDir().exists(_basePath)) {
 		QDir().mkpath(_basePath);
 	}
+	const auto compactDrafts = _draftsJournalCompact;
+	if (compactDrafts) {
+		compactDraftsJournal();
+	}
 
-	FileWriteDescriptor map(u"map"_q, _basePath);
+	// The journal is removed only after the draft files and the map that
+	// points to them are written, so both are written synchronously.
+	// This guard is destroyed after the map descriptor writes the file.
+	const auto removeDraftsJournal = gsl::finally([&] {
+		if (compactDrafts && _draftsJournalKey) {
+			QFile::remove(draftsJournalPath());
+		}
+	});
+	FileWriteDescriptor map(u"map"_q, _basePath, compactDrafts);
 	map.writeData(QByteArray());
 	map.writeData(QByteArray());
 
@@ -531,6 +564,8 @@ void Account::writeMap() {
 	if (_settingsKey) mapSize += sizeof(quint32) + sizeof(quint64);
 	if (_recentHashtagsAndBotsKey) mapSize += sizeof(quint32) + sizeof(quint64);
 	if (_exportSettingsKey) mapSize += sizeof(quint32) + sizeof(quint64);
+	if (_chatListSnapshotKey) mapSize += sizeof(quint32) + sizeof(quint64);
+	if (_draftsJournalKey) mapSize += sizeof(quint32) + sizeof(quint64);
 	if (_installedMasksKey || _recentMasksKey || _archivedMasksKey) {
 		mapSize += sizeof(quint32) + 3 * sizeof(quint64);
 	}
@@ -596,6 +631,12 @@ void Account::writeMap() {
 			<< quint64(_featuredCustomEmojiKey)
 			<< quint64(_archivedCustomEmojiKey);
 	}
+	if (_chatListSnapshotKey) {
+		mapData.stream << quint32(lskChatListSnapshot) << quint64(_chatListSnapshotKey);
+	}
+	if (_draftsJournalKey) {
+		mapData.stream << quint32(lskDraftsJournal) << quint64(_draftsJournalKey);
+	}
 	map.writeEncrypted(mapData, _localKey);
 
 	_mapChanged = false;
@@ -606,6 +647,9 @@ void Account::reset() {
 	_draftsMap.clear();
 	_draftCursorsMap.clear();
 	_draftsNotReadMap.clear();
+	_draftsJournal.clear();
+	_draftsJournalKey = 0;
+	_draftsJournalCompact = false;
 	_locationsKey = _trustedBotsKey = 0;
 	_recentStickersKeyOld = 0;
 	_installedStickersKey = 0;
@@ -622,6 +666,7 @@ void Account::reset() {
 	_archivedCustomEmojiKey = 0;
 	_legacyBackgroundKeyDay = _legacyBackgroundKeyNight = 0;
 	_settingsKey = _recentHashtagsAndBotsKey = _exportSettingsKey = 0;
+	_chatListSnapshotKey = 0;
 	_oldMapVersion = 0;
 	_fileLocations.clear();
 	_fileLocationPairs.clear();
@@ -1099,23 +1144,11 @@ void Account::writeDrafts(not_null<History*> history) {
 		sources,
 		[&](auto&&...) { ++count; });
 	if (!count) {
-		auto i = _draftsMap.find(peerId);
-		if (i != _draftsMap.cend()) {
-			ClearKey(i->second, _basePath);
-			_draftsMap.erase(i);
-			writeMapDelayed();
-		}
-
+		clearDrafts(peerId);
 		_draftsNotReadMap.remove(peerId);
 		return;
 	}
 
-	auto i = _draftsMap.find(peerId);
-	if (i == _draftsMap.cend()) {
-		i = _draftsMap.emplace(peerId, GenerateKey(_basePath)).first;
-		writeMapQueued();
-	}
-
 	auto size = int(sizeof(quint64) * 2 + sizeof(quint32));
 	const auto sizeCallback = [&](
 			auto&&, // key
@@ -1134,8 +1167,11 @@ void Account::writeDrafts(not_null<History*> history) {
 		sources,
 		sizeCallback);
 
-	EncryptedDescriptor data(size);
-	data.stream
+	auto payload = QByteArray();
+	payload.reserve(size);
+	QDataStream stream(&payload, QIODevice::WriteOnly);
+	stream.setVersion(QDataStream::Qt_5_1);
+	stream
 		<< quint64(kMultiDraftTag)
 		<< SerializePeerId(peerId)
 		<< quint32(count);
@@ -1146,7 +1182,7 @@ void Account::writeDrafts(not_null<History*> history) {
 			const TextWithTags &text,
 			Data::PreviewState previewState,
 			auto&&) { // cursor
-		data.stream
+		stream
 			<< key.serialize()
 			<< text.text
 			<< TextUtilities::SerializeTags(text.tags)
@@ -1159,8 +1195,7 @@ void Account::writeDrafts(not_null<History*> history) {
 		sources,
 		writeCallback);
 
-	FileWriteDescriptor file(i->second, _basePath);
-	file.writeEncrypted(data, _localKey);
+	appendDraftsJournal(peerId, DraftsJournalPart::Drafts, payload);
 
 	_draftsNotReadMap.remove(peerId);
 }
@@ -1183,18 +1218,16 @@ void Account::writeDraftCursors(not_null<History*> history) {
 		clearDraftCursors(peerId);
 		return;
 	}
-	auto i = _draftCursorsMap.find(peerId);
-	if (i == _draftCursorsMap.cend()) {
-		i = _draftCursorsMap.emplace(peerId, GenerateKey(_basePath)).first;
-		writeMapQueued();
-	}
 
 	auto size = int(sizeof(quint64) * 2
 		+ sizeof(quint32)
 		+ (sizeof(qint64) + sizeof(qint32) * 3) * count);
 
-	EncryptedDescriptor data(size);
-	data.stream
+	auto payload = QByteArray();
+	payload.reserve(size);
+	QDataStream stream(&payload, QIODevice::WriteOnly);
+	stream.setVersion(QDataStream::Qt_5_1);
+	stream
 		<< quint64(kMultiDraftCursorsTag)
 		<< SerializePeerId(peerId)
 		<< quint32(count);
@@ -1205,7 +1238,7 @@ void Account::writeDraftCursors(not_null<History*> history) {
 			auto&&, // text
 			Data::PreviewState,
 			const MessageCursor &cursor) { // cursor
-		data.stream
+		stream
 			<< key.serialize()
 			<< qint32(cursor.position)
 			<< qint32(cursor.anchor)
@@ -1217,27 +1250,206 @@ void Account::writeDraftCursors(not_null<History*> history) {
 		sources,
 		writeCallback);
 
-	FileWriteDescriptor file(i->second, _basePath);
-	file.writeEncrypted(data, _localKey);
+	appendDraftsJournal(peerId, DraftsJournalPart::Cursors, payload);
 }
 
 void Account::clearDraftCursors(PeerId peerId) {
-	const auto i = _draftCursorsMap.find(peerId);
-	if (i != _draftCursorsMap.cend()) {
-		ClearKey(i->second, _basePath);
-		_draftCursorsMap.erase(i);
+	if (hasDraftCursors(peerId)) {
+		appendDraftsJournal(peerId, DraftsJournalPart::Cursors, {});
+	}
+}
+
+void Account::clearDrafts(PeerId peerId) {
+	if (hasDraft(peerId)) {
+		appendDraftsJournal(peerId, DraftsJournalPart::Drafts, {});
+	}
+}
+
+QString Account::draftsJournalPath() const {
+	Expects(_draftsJournalKey != 0);
+
+	return _basePath + ToFilePart(_draftsJournalKey) + 's';
+}
+
+void Account::appendDraftsJournal(
+		PeerId peerId,
+		DraftsJournalPart part,
+		const QByteArray &payload) {
+	auto &entry = _draftsJournal[peerId];
+	((part == DraftsJournalPart::Drafts)
+		? entry.drafts
+		: entry.cursors) = payload;
+
+	if (!_draftsJournalKey) {
+		_draftsJournalKey = GenerateKey(_basePath);
+		writeMapQueued();
+	}
+	if (!QDir().exists(_basePath)) {
+		QDir().mkpath(_basePath);
+	}
+
+	EncryptedDescriptor record(sizeof(quint32)
+		+ sizeof(quint64)
+		+ Serialize::bytearraySize(payload));
+	record.stream
+		<< quint32(part)
+		<< SerializePeerId(peerId)
+		<< payload;
+	const auto encrypted = PrepareEncrypted(record, _localKey);
+
+	QFile file(draftsJournalPath());
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+		LOG(("App Error: Could not open drafts journal for writing."));
+		_draftsJournalCompact = true;
+		writeMapDelayed();
+		return;
+	}
+	if (!file.size()) {
+		file.write(kDraftsJournalMagic, kDraftsJournalMagicLen);
+	}
+	QDataStream stream(&file);
+	stream.setVersion(QDataStream::Qt_5_1);
+	stream << encrypted;
+	const auto size = file.size();
+	file.close();
+
+	if (size > kDraftsJournalCompactSize && !_draftsJournalCompact) {
+		_draftsJournalCompact = true;
 		writeMapDelayed();
 	}
 }
 
+void Account::readDraftsJournal() {
+	QFile file(draftsJournalPath());
+	if (!file.open(QIODevice::ReadOnly)) {
+		return;
+	}
+	const auto magic = file.read(kDraftsJournalMagicLen);
+	if (magic != QByteArray::fromRawData(
+			kDraftsJournalMagic,
+			kDraftsJournalMagicLen)) {
+		LOG(("App Error: Bad drafts journal magic."));
+		file.close();
+		QFile::remove(draftsJournalPath());
+		return;
+	}
+	QDataStream stream(&file);
+	stream.setVersion(QDataStream::Qt_5_1);
+	auto records = 0;
+	while (!stream.atEnd()) {
+		auto encrypted = QByteArray();
+		stream >> encrypted;
+
+		// A record could be cut off if the app was killed while writing.
+		EncryptedDescriptor record;
+		if (stream.status() != QDataStream::Ok
+			|| !DecryptLocal(record, encrypted, _localKey)) {
+			LOG(("App Error: Bad record in drafts journal."));
+			break;
+		}
+		auto part = quint32();
+		auto peerIdSerialized = quint64();
+		auto payload = QByteArray();
+		record.stream >> part >> peerIdSerialized >> payload;
+		if (!CheckStreamStatus(record.stream)) {
+			break;
+		}
+		const auto peerId = DeserializePeerId(peerIdSerialized);
+		auto &entry = _draftsJournal[peerId];
+		switch (DraftsJournalPart(part)) {
+		case DraftsJournalPart::Drafts: entry.drafts = payload; break;
+		case DraftsJournalPart::Cursors: entry.cursors = payload; break;
+		}
+		++records;
+	}
+	file.close();
+
+	for (const auto &[peerId, entry] : _draftsJournal) {
+		if (!entry.drafts) {
+			continue;
+		} else if (entry.drafts->isEmpty()) {
+			_draftsNotReadMap.remove(peerId);
+		} else {
+			_draftsNotReadMap.emplace(peerId, true);
+		}
+	}
+	DEBUG_LOG(("App Info: Read %1 records for %2 peers from drafts journal."
+		).arg(records
+		).arg(_draftsJournal.size()));
+
+	// Fold the journal of the previous run into the draft files.
+	_draftsJournalCompact = true;
+	writeMapDelayed();
+}
+
+void Account::compactDraftsJournal() {
+	_draftsJournalCompact = false;
+	for (const auto &[peerId, entry] : base::take(_draftsJournal)) {
+		if (entry.drafts) {
+			writeDraftsPart(_draftsMap, peerId, *entry.drafts);
+		}
+		if (entry.cursors) {
+			writeDraftsPart(_draftCursorsMap, peerId, *entry.cursors);
+		}
+	}
+}
+
+void Account::writeDraftsPart(
+		base::flat_map<PeerId, FileKey> &map,
+		PeerId peerId,
+		const QByteArray &payload) {
+	auto i = map.find(peerId);
+	if (payload.isEmpty()) {
+		if (i != map.end()) {
+			ClearKey(i->second, _basePath);
+			map.erase(i);
+		}
+		return;
+	} else if (i == map.end()) {
+		i = map.emplace(peerId, GenerateKey(_basePath)).first;
+	}
+	EncryptedDescriptor data(payload.size());
+	data.stream.writeRawData(payload.constData(), payload.size());
+
+	const auto sync = true;
+	FileWriteDescriptor file(i->second, _basePath, sync);
+	file.writeEncrypted(data, _localKey);
+}
+
+bool Account::readDraftsPart(
+		FileReadDescriptor &result,
+		PeerId peerId,
+		DraftsJournalPart part) {
+	const auto drafts = (part == DraftsJournalPart::Drafts);
+	const auto j = _draftsJournal.find(peerId);
+	if (j != end(_draftsJournal)) {
+		const auto &payload = drafts ? j->second.drafts : j->second.cursors;
+		if (payload) {
+			if (payload->isEmpty()) {
+				return false;
+			}
+			result.version = AppVersion;
+			result.data = *payload;
+			result.buffer.setBuffer(&result.data);
+			result.buffer.open(QIODevice::ReadOnly);
+			result.stream.setDevice(&result.buffer);
+			result.stream.setVersion(QDataStream::Qt_5_1);
+			return true;
+		}
+	}
+	const auto &map = drafts ? _draftsMap : _draftCursorsMap;
+	const auto i = map.find(peerId);
+	return (i != map.end())
+		&& ReadEncryptedFile(result, i->second, _basePath, _localKey);
+}
+
 void Account::readDraftCursors(PeerId peerId, Data::HistoryDrafts &map) {
-	const auto j = _draftCursorsMap.find(peerId);
-	if (j == _draftCursorsMap.cend()) {
+	if (!hasDraftCursors(peerId)) {
 		return;
 	}
 
 	FileReadDescriptor draft;
-	if (!ReadEncryptedFile(draft, j->second, _basePath, _localKey)) {
+	if (!readDraftsPart(draft, peerId, DraftsJournalPart::Cursors)) {
 		clearDraftCursors(peerId);
 		return;
 	}
@@ -1328,15 +1540,13 @@ void Account::readDraftsWithCursors(not_null<History*> history) {
 		return;
 	}
 
-	const auto j = _draftsMap.find(peerId);
-	if (j == _draftsMap.cend()) {
+	if (!hasDraft(peerId)) {
 		clearDraftCursors(peerId);
 		return;
 	}
 	FileReadDescriptor draft;
-	if (!ReadEncryptedFile(draft, j->second, _basePath, _localKey)) {
-		ClearKey(j->second, _basePath);
-		_draftsMap.erase(j);
+	if (!readDraftsPart(draft, peerId, DraftsJournalPart::Drafts)) {
+		clearDrafts(peerId);
 		clearDraftCursors(peerId);
 		return;
 	}
@@ -1352,8 +1562,7 @@ void Account::readDraftsWithCursors(not_null<History*> history) {
 	draft.stream >> draftPeerSerialized >> count;
 	const auto draftPeer = DeserializePeerId(draftPeerSerialized);
 	if (!count || count > 1000 || draftPeer != peerId) {
-		ClearKey(j->second, _basePath);
-		_draftsMap.erase(j);
+		clearDrafts(peerId);
 		clearDraftCursors(peerId);
 		return;
 	}
@@ -1396,8 +1605,7 @@ void Account::readDraftsWithCursors(not_null<History*> history) {
 		}
 	}
 	if (draft.stream.status() != QDataStream::Ok) {
-		ClearKey(j->second, _basePath);
-		_draftsMap.erase(j);
+		clearDrafts(peerId);
 		clearDraftCursors(peerId);
 		return;
 	}
@@ -1432,11 +1640,7 @@ void Account::readDraftsWithCursorsLegacy(
 	const auto peerId = history->peer->id;
 	const auto draftPeer = DeserializePeerId(draftPeerSerialized);
 	if (draftPeer != peerId) {
-		const auto j = _draftsMap.find(peerId);
-		if (j != _draftsMap.cend()) {
-			ClearKey(j->second, _basePath);
-			_draftsMap.erase(j);
-		}
+		clearDrafts(peerId);
 		clearDraftCursors(peerId);
 		return;
 	}
@@ -1479,10 +1683,18 @@ void Account::readDraftsWithCursorsLegacy(
 }
 
 bool Account::hasDraftCursors(PeerId peer) {
+	const auto i = _draftsJournal.find(peer);
+	if (i != end(_draftsJournal) && i->second.cursors) {
+		return !i->second.cursors->isEmpty();
+	}
 	return _draftCursorsMap.contains(peer);
 }
 
 bool Account::hasDraft(PeerId peer) {
+	const auto i = _draftsJournal.find(peer);
+	if (i != end(_draftsJournal) && i->second.drafts) {
+		return !i->second.drafts->isEmpty();
+	}
 	return _draftsMap.contains(peer);
 }
 
@@ -2607,6 +2819,8 @@ void Account::writeExportSettings(const Export::Settings &settings) {
 		&& settings.path == check.path
 		&& settings.format == check.format
 		&& settings.availableAt == check.availableAt
+		&& settings.onlyNewMessages == check.onlyNewMessages
+		&& settings.packToArchive == check.packToArchive
 		&& !settings.onlySinglePeer()) {
 		if (_exportSettingsKey) {
 			ClearKey(_exportSettingsKey, _basePath);
@@ -2621,7 +2835,7 @@ void Account::writeExportSettings(const Export::Settings &settings) {
 	}
 	quint32 size = sizeof(quint32) * 6
 		+ Serialize::stringSize(settings.path)
-		+ sizeof(qint32) * 2 + sizeof(quint64);
+		+ sizeof(qint32) * 4 + sizeof(quint64);
 	EncryptedDescriptor data(size);
 	data.stream
 		<< quint32(settings.types)
@@ -2654,6 +2868,8 @@ void Account::writeExportSettings(const Export::Settings &settings) {
 	});
 	data.stream << qint32(settings.singlePeerFrom);
 	data.stream << qint32(settings.singlePeerTill);
+	data.stream << qint32(settings.onlyNewMessages ? 1 : 0);
+	data.stream << qint32(settings.packToArchive ? 1 : 0);
 
 	FileWriteDescriptor file(_exportSettingsKey, _basePath);
 	file.writeEncrypted(data, _localKey);
@@ -2676,6 +2892,7 @@ Export::Settings Account::readExportSettings() {
 	quint64 singlePeerBareId = 0;
 	quint64 singlePeerAccessHash = 0;
 	qint32 singlePeerFrom = 0, singlePeerTill = 0;
+	qint32 onlyNewMessages = 0, packToArchive = 0;
 	file.stream
 		>> types
 		>> fullChats
@@ -2706,6 +2923,12 @@ Export::Settings Account::readExportSettings() {
 	if (!file.stream.atEnd()) {
 		file.stream >> singlePeerFrom >> singlePeerTill;
 	}
+	if (!file.stream.atEnd()) {
+		file.stream >> onlyNewMessages;
+	}
+	if (!file.stream.atEnd()) {
+		file.stream >> packToArchive;
+	}
 	auto result = Export::Settings();
 	result.types = Export::Settings::Types::from_raw(types);
 	result.fullChats = Export::Settings::Types::from_raw(fullChats);
@@ -2746,11 +2969,49 @@ Export::Settings Account::readExportSettings() {
 	}();
 	result.singlePeerFrom = singlePeerFrom;
 	result.singlePeerTill = singlePeerTill;
+	result.onlyNewMessages = (onlyNewMessages == 1);
+	result.packToArchive = (packToArchive == 1);
 	return (file.stream.status() == QDataStream::Ok && result.validate())
 		? result
 		: Export::Settings();
 }
 
+void Account::writeChatListSnapshot(const QByteArray &serialized) {
+	if (serialized.isEmpty()) {
+		if (_chatListSnapshotKey) {
+			ClearKey(_chatListSnapshotKey, _basePath);
+			_chatListSnapshotKey = 0;
+			writeMapDelayed();
+		}
+		return;
+	}
+	if (!_chatListSnapshotKey) {
+		_chatListSnapshotKey = GenerateKey(_basePath);
+		writeMapQueued();
+	}
+	EncryptedDescriptor data(Serialize::bytearraySize(serialized));
+	data.stream << serialized;
+
+	FileWriteDescriptor file(_chatListSnapshotKey, _basePath);
+	file.writeEncrypted(data, _localKey);
+}
+
+QByteArray Account::readChatListSnapshot() {
+	if (!_chatListSnapshotKey) {
+		return QByteArray();
+	}
+	FileReadDescriptor file;
+	if (!ReadEncryptedFile(file, _chatListSnapshotKey, _basePath, _localKey)) {
+		ClearKey(_chatListSnapshotKey, _basePath);
+		_chatListSnapshotKey = 0;
+		writeMapDelayed();
+		return QByteArray();
+	}
+	auto result = QByteArray();
+	file.stream >> result;
+	return CheckStreamStatus(file.stream) ? result : QByteArray();
+}
+
 void Account::writeSelf() {
 	writeMapDelayed();
 }
@@ -148,6 +148,9 @@ public:
 	void writeExportSettings(const Export::Settings &settings);
 	[[nodiscard]] Export::Settings readExportSettings();
 
+	void writeChatListSnapshot(const QByteArray &serialized);
+	[[nodiscard]] QByteArray readChatListSnapshot();
+
 	void writeSelf();
 
 	// Read self is special, it can't get session from account, because
@@ -222,6 +225,7 @@ private:
 		quint64 draftPeerSerialized,
 		Data::HistoryDrafts &map);
 	void clearDraftCursors(PeerId peerId);
+	void clearDrafts(PeerId peerId);
 	void readDraftsWithCursorsLegacy(
 		not_null<History*> history,
 		details::FileReadDescriptor &draft,
@@ -244,6 +248,31 @@ private:
 	void readTrustedBots();
 	void writeTrustedBots();
 
+	enum class DraftsJournalPart : quint32 {
+		Drafts = 0x01,
+		Cursors = 0x02,
+	};
+	struct DraftsJournalEntry {
+		// Empty payload means the part was cleared.
+		std::optional<QByteArray> drafts;
+		std::optional<QByteArray> cursors;
+	};
+	[[nodiscard]] QString draftsJournalPath() const;
+	void appendDraftsJournal(
+		PeerId peerId,
+		DraftsJournalPart part,
+		const QByteArray &payload);
+	void readDraftsJournal();
+	void compactDraftsJournal();
+	void writeDraftsPart(
+		base::flat_map<PeerId, FileKey> &map,
+		PeerId peerId,
+		const QByteArray &payload);
+	[[nodiscard]] bool readDraftsPart(
+		details::FileReadDescriptor &result,
+		PeerId peerId,
+		DraftsJournalPart part);
+
 	std::optional<RecentHashtagPack> saveRecentHashtags(
 		Fn<RecentHashtagPack()> getPack,
 		const QString &text);
@@ -264,6 +293,12 @@ private:
 		not_null<History*>,
 		base::flat_map<Data::DraftKey, MessageDraftSource>> _draftSources;
 
+	// Draft changes are appended to one journal file and are written
+	// to the per-peer files above only when the journal is compacted.
+	base::flat_map<PeerId, DraftsJournalEntry> _draftsJournal;
+	FileKey _draftsJournalKey = 0;
+	bool _draftsJournalCompact = false;
+
 	QMultiMap<MediaKey, Core::FileLocation> _fileLocations;
 	QMap<QString, QPair<MediaKey, Core::FileLocation>> _fileLocationPairs;
 	QMap<MediaKey, MediaKey> _fileLocationAliases;
@@ -286,6 +321,7 @@ private:
 	FileKey _settingsKey = 0;
 	FileKey _recentHashtagsAndBotsKey = 0;
 	FileKey _exportSettingsKey = 0;
+	FileKey _chatListSnapshotKey = 0;
 	FileKey _installedMasksKey = 0;
 	FileKey _recentMasksKey = 0;
 	FileKey _installedCustomEmojiKey = 0;
@@ -0,0 +1,90 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "storage/storage_cache_stats.h"
+
+#include "data/data_types.h"
+
+namespace Storage {
+namespace {
+
+[[nodiscard]] QString TagName(CacheStatsTag tag) {
+	switch (tag) {
+	case CacheStatsTag::Photos: return u"photos"_q;
+	case CacheStatsTag::Stickers: return u"stickers"_q;
+	case CacheStatsTag::VideoParts: return u"video parts"_q;
+	case CacheStatsTag::Emoji: return u"emoji"_q;
+	case CacheStatsTag::Other: return u"other"_q;
+	}
+	Unexpected("Tag in Storage::TagName.");
+}
+
+} // namespace
+
+CacheStatsTag CacheStats::TagFromCacheTag(uint8 tag) {
+	switch (tag) {
+	case Data::kImageCacheTag: return CacheStatsTag::Photos;
+	case Data::kStickerCacheTag: return CacheStatsTag::Stickers;
+	case Data::kVideoMessageCacheTag:
+	case Data::kAnimationCacheTag: return CacheStatsTag::VideoParts;
+	}
+	return CacheStatsTag::Other;
+}
+
+void CacheStats::read(CacheStatsTag tag, int64 bytes) {
+	auto &counters = this->counters(tag);
+	if (bytes > 0) {
+		counters.hits.fetch_add(1, std::memory_order_relaxed);
+		counters.bytesRead.fetch_add(bytes, std::memory_order_relaxed);
+	} else {
+		counters.misses.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+void CacheStats::written(CacheStatsTag tag, int64 bytes) {
+	counters(tag).bytesWritten.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+auto CacheStats::counters(CacheStatsTag tag) -> AtomicCounters & {
+	Expects(int(tag) >= 0 && int(tag) < kCacheStatsTagCount);
+
+	return _counters[int(tag)];
+}
+
+auto CacheStats::counters(CacheStatsTag tag) const -> Counters {
+	Expects(int(tag) >= 0 && int(tag) < kCacheStatsTagCount);
+
+	const auto &counters = _counters[int(tag)];
+	return {
+		.hits = counters.hits.load(std::memory_order_relaxed),
+		.misses = counters.misses.load(std::memory_order_relaxed),
+		.bytesRead = counters.bytesRead.load(std::memory_order_relaxed),
+		.bytesWritten = counters.bytesWritten.load(
+			std::memory_order_relaxed),
+	};
+}
+
+void CacheStats::log() const {
+	for (auto i = 0; i != kCacheStatsTagCount; ++i) {
+		const auto tag = CacheStatsTag(i);
+		const auto now = counters(tag);
+		const auto requests = now.hits + now.misses;
+		if (!requests && !now.bytesWritten) {
+			continue;
+		}
+		DEBUG_LOG(("Cache Stats: %1 - %2 hits, %3 misses (%4%), "
+			"%5 KB read, %6 KB written."
+			).arg(TagName(tag)
+			).arg(now.hits
+			).arg(now.misses
+			).arg(requests ? (now.hits * 100 / requests) : 0
+			).arg(now.bytesRead / 1024
+			).arg(now.bytesWritten / 1024));
+	}
+}
+
+} // namespace Storage
@@ -0,0 +1,60 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+#include <array>
+#include <atomic>
+
+namespace Storage {
+
+enum class CacheStatsTag : uchar {
+	Photos,
+	Stickers,
+	VideoParts,
+	Emoji,
+	Other,
+};
+
+inline constexpr auto kCacheStatsTagCount = int(CacheStatsTag::Other) + 1;
+
+// Counts reads and writes of the cache databases of one session, so that
+// the hit rate of the cache for different kinds of media can be measured.
+// May be used from any thread.
+class CacheStats final {
+public:
+	struct Counters {
+		int64 hits = 0;
+		int64 misses = 0;
+		int64 bytesRead = 0;
+		int64 bytesWritten = 0;
+	};
+
+	[[nodiscard]] static CacheStatsTag TagFromCacheTag(uint8 tag);
+
+	// Empty value means the key was not found in the cache.
+	void read(CacheStatsTag tag, int64 bytes);
+	void written(CacheStatsTag tag, int64 bytes);
+
+	[[nodiscard]] Counters counters(CacheStatsTag tag) const;
+	void log() const;
+
+private:
+	struct AtomicCounters {
+		std::atomic<int64> hits = 0;
+		std::atomic<int64> misses = 0;
+		std::atomic<int64> bytesRead = 0;
+		std::atomic<int64> bytesWritten = 0;
+	};
+
+	[[nodiscard]] AtomicCounters &counters(CacheStatsTag tag);
+
+	std::array<AtomicCounters, kCacheStatsTagCount> _counters;
+
+};
+
+} // namespace Storage
@@ -10,6 +10,8 @@ init_target(lib_ffmpeg)
 
 nice_target_sources(lib_ffmpeg ${src_loc}
 PRIVATE
+    ffmpeg/ffmpeg_frame_cache.cpp
+    ffmpeg/ffmpeg_frame_cache.h
     ffmpeg/ffmpeg_frame_generator.cpp
     ffmpeg/ffmpeg_frame_generator.h
     ffmpeg/ffmpeg_utility.cpp
@@ -26,6 +28,8 @@ PUBLIC
     desktop-app::lib_base
     desktop-app::lib_ui
     desktop-app::external_ffmpeg
+PRIVATE
+    desktop-app::external_xxhash
 )
 
 if (DESKTOP_APP_SPECIAL_TARGET)
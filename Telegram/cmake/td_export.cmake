@@ -31,6 +31,8 @@ PRIVATE
     export/output/export_output_result.h
     export/output/export_output_stats.cpp
     export/output/export_output_stats.h
+    export/output/export_output_zip.cpp
+    export/output/export_output_zip.h
 )
 
 target_include_directories(td_export